@@ -6,6 +6,15 @@
 #define UV_UV_HPP
 
 #include "uv++/loop.hpp"
+#include "uv++/actor.hpp"
+#include "uv++/rcu.hpp"
+#include "uv++/sync.hpp"
+#include "uv++/bus.hpp"
+#include "uv++/when.hpp"
+#include "uv++/group.hpp"
+#include "uv++/multiwork.hpp"
+#include "uv++/coro.hpp"
+#include "uv++/fiber.hpp"
 #include "uv++/os.hpp"
 #include "uv++/net.hpp"
 #include "uv++/misc.hpp"
@@ -0,0 +1,162 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_ACTOR_HPP
+#define UV_ACTOR_HPP
+
+#include "loop.hpp"
+
+namespace uv {
+    /*
+     * Base class for objects that are pinned to a single loop and only ever touched from that loop's thread.
+     *
+     * Other threads talk to an actor by sending it typed messages, which are queued in a Channel and handed to
+     * receive() on the loop thread in batches. tell() doesn't allocate, since messages are stored directly in the
+     * mailbox ring, and ask() returns a future for the reply.
+     *
+     * Actors are created with uv::spawn, and the mailbox is closed when the actor is destroyed.
+     * */
+    template <typename Message, typename Reply = void>
+    class Actor : public std::enable_shared_from_this<Actor<Message, Reply>> {
+        public:
+            typedef Message message_type;
+            typedef Reply   reply_type;
+
+            struct Stats {
+                //Messages waiting right now
+                size_t depth;
+
+                //Most messages ever waiting at once
+                size_t high_water;
+
+                size_t processed;
+
+                //Number of times the mailbox was drained
+                size_t batches;
+            };
+
+        protected:
+            template <typename A, typename... Args>
+            friend std::shared_ptr<A> spawn( std::shared_ptr<Loop>, Args &&... );
+
+            struct Envelope {
+                Message message;
+
+                //Only there for ask
+                std::unique_ptr<std::promise<Reply>> reply;
+            };
+
+            std::shared_ptr<Loop>              _loop;
+            std::shared_ptr<Channel<Envelope>> mailbox;
+            size_t                             capacity;
+
+            std::atomic<size_t> high_water;
+            std::atomic<size_t> processed;
+            std::atomic<size_t> batches;
+
+            inline explicit Actor( size_t capacity = UV_ACTOR_MAILBOX_CAPACITY ) noexcept
+                : capacity( capacity ), high_water( 0 ), processed( 0 ), batches( 0 ) {
+            }
+
+            /*
+             * Handles a single message on the loop thread. Exceptions thrown from here are passed on to ask() futures,
+             * and dropped for tell().
+             * */
+            virtual Reply receive( Message & ) = 0;
+
+            void deliver( Span<Envelope> batch ) {
+                auto f = [this]( Message &m ) {
+                    return this->receive( m );
+                };
+
+                for( Envelope &e : batch ) {
+                    if( e.reply ) {
+                        detail::dispatch_helper<Reply>::dispatch( *e.reply, f, std::forward_as_tuple( e.message ));
+
+                    } else {
+                        detail::dispatch_nowait( f, std::forward_as_tuple( e.message ));
+                    }
+                }
+
+                //Only the loop thread writes these, so there's no need for anything more than relaxed stores
+                if( batch.size() > this->high_water.load( std::memory_order_relaxed )) {
+                    this->high_water.store( batch.size(), std::memory_order_relaxed );
+                }
+
+                this->processed.store( this->processed.load( std::memory_order_relaxed ) + batch.size(), std::memory_order_relaxed );
+                this->batches.store( this->batches.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+            }
+
+            void start( std::shared_ptr<Loop> l ) {
+                std::weak_ptr<Actor> weak = this->shared_from_this();
+
+                this->_loop  = l;
+                this->mailbox = l->channel<Envelope>( [weak]( Span<Envelope> batch ) {
+                    if( auto self = weak.lock()) {
+                        self->deliver( batch );
+                    }
+                }, this->capacity );
+            }
+
+        public:
+            Actor( const Actor & ) = delete;
+
+            inline std::shared_ptr<Loop> loop() const noexcept {
+                return this->_loop;
+            }
+
+            /*
+             * Sends a message without waiting for a reply, from any thread.
+             *
+             * Returns false if the mailbox is full or closed, in which case the message is dropped.
+             * */
+            inline bool tell( Message m ) {
+                return this->mailbox->emplace( Envelope{ std::move( m ), nullptr } );
+            }
+
+            /*
+             * Sends a message and returns a future for the reply.
+             *
+             * If the mailbox is full the future holds an exception with UV_ENOBUFS.
+             * */
+            std::shared_future<Reply> ask( Message m ) {
+                auto p = std::make_unique<std::promise<Reply>>();
+
+                std::shared_future<Reply> ret = p->get_future();
+
+                if( !this->mailbox->emplace( Envelope{ std::move( m ), std::move( p ) } )) {
+                    return detail::make_exception_future<Reply>( ::uv::Exception( UV_ENOBUFS ));
+                }
+
+                return ret;
+            }
+
+            Stats stats() const noexcept {
+                return Stats{ this->mailbox->size(),
+                              this->high_water.load( std::memory_order_relaxed ),
+                              this->processed.load( std::memory_order_relaxed ),
+                              this->batches.load( std::memory_order_relaxed ) };
+            }
+
+            virtual ~Actor() {
+                if( this->mailbox ) {
+                    this->mailbox->close( [] {} );
+                }
+            }
+    };
+
+    /*
+     * Creates an actor of type A on the given loop, forwarding the rest of the arguments to its constructor.
+     * */
+    template <typename A, typename... Args>
+    inline std::shared_ptr<A> spawn( std::shared_ptr<Loop> l, Args &&... args ) {
+        auto a = std::make_shared<A>( std::forward<Args>( args )... );
+
+        a->start( l );
+
+        return a;
+    }
+}
+
+#endif //UV_ACTOR_HPP
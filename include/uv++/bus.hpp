@@ -0,0 +1,464 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_BUS_HPP
+#define UV_BUS_HPP
+
+#include "loop.hpp"
+#include "rcu.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+namespace uv {
+    /*
+     * Topic based publish/subscribe across any number of loops.
+     *
+     * Payloads are immutable and reference counted. Publishing sends one reference to each loop that has subscribers
+     * for the topic, through a Channel per loop, and each loop then runs all of its local subscribers in one pass.
+     * So publishing costs the same whether a loop has one subscriber or a thousand.
+     *
+     * If a loop falls behind and its channel fills up, new payloads for it are either dropped, or conflated so the loop
+     * only sees the latest payload for each topic once it catches up.
+     *
+     * Subscription tables are copy-on-write, so publishers and loops never take a lock to look them up. Each loop's
+     * table is an Rcu, since only that loop reads it. The routes are read by publishers on any thread, so readers
+     * count themselves in against one of two epochs, and a writer waits out the older epoch before freeing a table.
+     * */
+    template <typename Topic, typename Payload>
+    class Bus : public std::enable_shared_from_this<Bus<Topic, Payload>> {
+        public:
+            typedef Topic                          topic_type;
+            typedef Payload                        payload_type;
+            typedef std::shared_ptr<const Payload> payload_ptr;
+
+            typedef std::function<void( const Topic &, const payload_ptr & )> subscriber_type;
+
+            enum class overflow_policy {
+                    DROP,
+                    CONFLATE
+            };
+
+            struct Stats {
+                size_t published;
+                size_t dropped;
+                size_t conflated;
+            };
+
+        protected:
+            struct Delivery {
+                Topic       topic;
+                payload_ptr payload;
+            };
+
+            struct Subscriber {
+                uint64_t        id;
+                subscriber_type f;
+            };
+
+            typedef std::unordered_map<Topic, std::vector<Subscriber>> sub_table;
+
+            //Everything the bus needs for a single loop
+            struct Node {
+                std::weak_ptr<Loop>                loop;
+                std::shared_ptr<Channel<Delivery>> channel;
+
+                //Only replaced under the bus mutex, and only read on this node's loop, which is attached to the domain
+                Rcu<sub_table> subs;
+
+                //Payloads waiting for space in the channel, latest per topic, when conflating
+                std::mutex                           overflow_mutex;
+                std::unordered_map<Topic, payload_ptr> overflow;
+                std::atomic_bool                     has_overflow;
+
+                inline explicit Node( std::shared_ptr<RcuDomain> domain )
+                    : subs( std::move( domain )), has_overflow( false ) {
+                }
+
+                void dispatch( const Topic &topic, const payload_ptr &payload, const sub_table &table ) {
+                    auto it = table.find( topic );
+
+                    if( it != table.end()) {
+                        for( const Subscriber &s : it->second ) {
+                            s.f( topic, payload );
+                        }
+                    }
+                }
+
+                //A subscriber can change the table from in here, but the one this read stays valid until it returns
+                void deliver( Span<Delivery> batch ) {
+                    const sub_table *table = this->subs.get();
+
+                    for( Delivery &d : batch ) {
+                        this->dispatch( d.topic, d.payload, *table );
+                    }
+
+                    this->drain_overflow();
+                }
+
+                /*
+                 * Conflated payloads are newer than anything still in the channel, so they're only delivered once the
+                 * channel is empty. Until then, the channel keeps coming back around for the rest of its values.
+                 * */
+                void drain_overflow() {
+                    if( !this->has_overflow.load( std::memory_order_acquire ) || !this->channel->empty()) {
+                        return;
+                    }
+
+                    std::unordered_map<Topic, payload_ptr> pending;
+
+                    {
+                        std::lock_guard<std::mutex> lock( this->overflow_mutex );
+
+                        pending.swap( this->overflow );
+
+                        this->has_overflow.store( false, std::memory_order_release );
+                    }
+
+                    const sub_table *table = this->subs.get();
+
+                    for( auto &p : pending ) {
+                        this->dispatch( p.first, p.second, *table );
+                    }
+                }
+            };
+
+            typedef std::unordered_map<Topic, std::vector<std::shared_ptr<Node>>> route_table;
+
+            //Counts a publisher in against the current epoch for as long as it's using the route table
+            class RouteReader {
+                protected:
+                    std::atomic<size_t> &count;
+
+                public:
+                    const route_table *table;
+
+                    inline explicit RouteReader( Bus *b ) noexcept
+                        : count( b->route_readers[b->route_epoch.load() & 1].value ) {
+                        this->count.fetch_add( 1 );
+
+                        this->table = b->routes.load();
+                    }
+
+                    RouteReader( const RouteReader & ) = delete;
+
+                    ~RouteReader() {
+                        this->count.fetch_sub( 1, std::memory_order_release );
+                    }
+            };
+
+            struct alignas( 64 ) ReaderCount {
+                std::atomic<size_t> value;
+            };
+
+            size_t          capacity;
+            overflow_policy policy;
+
+            std::shared_ptr<RcuDomain> domain;
+
+            std::mutex                                   mutex;
+            std::atomic<const route_table *>             routes;
+            std::atomic<size_t>                          route_epoch;
+            ReaderCount                                  route_readers[2];
+            std::unordered_map<Loop *, std::shared_ptr<Node>> nodes;
+            std::unordered_map<uint64_t, std::pair<std::shared_ptr<Node>, Topic>> ids;
+            uint64_t                                     next_id = 1;
+
+            //Subscriptions handed out but not yet added on their loop
+            std::unordered_set<uint64_t> pending;
+
+            std::atomic<size_t> published;
+            std::atomic<size_t> dropped;
+            std::atomic<size_t> conflated;
+
+            /*
+             * Gets or creates the node for a loop, on that loop's thread and without the mutex held. Creating the
+             * channel and attaching the loop both make handles, which would otherwise wait on the loop to get to them.
+             * */
+            std::shared_ptr<Node> node_for( const std::shared_ptr<Loop> &l ) {
+                assert( detail::loop_on_thread( l.get()));
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    auto it = this->nodes.find( l.get());
+
+                    if( it != this->nodes.end()) {
+                        return it->second;
+                    }
+                }
+
+                this->domain->attach( l );
+
+                auto node = std::make_shared<Node>( this->domain );
+
+                std::weak_ptr<Node> weak = node;
+
+                node->loop    = l;
+                node->channel = l->channel<Delivery>( [weak]( Span<Delivery> batch ) {
+                    if( auto n = weak.lock()) {
+                        n->deliver( batch );
+                    }
+                }, this->capacity );
+
+                std::lock_guard<std::mutex> lock( this->mutex );
+
+                //Only this loop's thread creates its node, so nobody else could have beaten it here
+                this->nodes.emplace( l.get(), node );
+
+                return node;
+            }
+
+            //Adds a subscriber handed out by subscribe, on the loop it runs on
+            void add( const std::shared_ptr<Loop> &l, uint64_t id, const Topic &topic, subscriber_type f ) {
+                auto node = this->node_for( l );
+
+                std::lock_guard<std::mutex> lock( this->mutex );
+
+                //Unsubscribed before it got here
+                if( this->pending.erase( id ) == 0 ) {
+                    return;
+                }
+
+                std::unique_ptr<sub_table> next( new sub_table( *node->subs ));
+
+                ( *next )[topic].push_back( Subscriber{ id, std::move( f ) } );
+
+                node->subs.publish( std::move( next ));
+
+                this->update_routes( topic, node, true );
+
+                this->ids.emplace( id, std::make_pair( node, topic ));
+            }
+
+            /*
+             * Swaps in a new route table with the mutex held, and frees the old one once no publisher can be using it.
+             *
+             * Flipping the epoch sends new readers to the other count, so each wait only covers readers that were
+             * already there and can't go on forever. Anyone who counted themselves in after the swap has the new table,
+             * but only after waiting out both counts is it certain that nobody is left with the old one.
+             * */
+            void replace_routes( route_table *next ) {
+                const route_table *old = this->routes.exchange( next );
+
+                for( int i = 0; i < 2; ++i ) {
+                    size_t side = this->route_epoch.fetch_add( 1 ) & 1;
+
+                    while( this->route_readers[side].value.load() != 0 ) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                delete old;
+            }
+
+            //Copies the route table with the node added to or removed from a topic, with the mutex held
+            void update_routes( const Topic &topic, const std::shared_ptr<Node> &node, bool add ) {
+                std::unique_ptr<route_table> next( new route_table( *this->routes.load()));
+
+                auto &list = ( *next )[topic];
+
+                auto it = std::find( list.begin(), list.end(), node );
+
+                if( add && it == list.end()) {
+                    list.push_back( node );
+
+                } else if( !add && it != list.end()) {
+                    list.erase( it );
+
+                    if( list.empty()) {
+                        next->erase( topic );
+                    }
+                }
+
+                this->replace_routes( next.release());
+            }
+
+            void overflow( const std::shared_ptr<Node> &node, const Topic &topic, const payload_ptr &payload ) {
+                if( this->policy == overflow_policy::DROP ) {
+                    this->dropped.fetch_add( 1, std::memory_order_relaxed );
+
+                    return;
+                }
+
+                bool first;
+
+                {
+                    std::lock_guard<std::mutex> lock( node->overflow_mutex );
+
+                    first = node->overflow.empty();
+
+                    auto it = node->overflow.find( topic );
+
+                    if( it != node->overflow.end()) {
+                        it->second = payload;
+
+                        this->conflated.fetch_add( 1, std::memory_order_relaxed );
+
+                    } else {
+                        node->overflow.emplace( topic, payload );
+                    }
+
+                    node->has_overflow.store( true, std::memory_order_release );
+                }
+
+                /*
+                 * The channel may have drained between the failed push and now, so make sure the loop comes back
+                 * around for the overflow even if nothing else is published.
+                 * */
+                if( first ) {
+                    if( auto l = node->loop.lock()) {
+                        std::weak_ptr<Node> weak = node;
+
+                        l->post( [weak] {
+                            if( auto n = weak.lock()) {
+                                n->drain_overflow();
+                            }
+                        } );
+                    }
+                }
+            }
+
+        public:
+            inline Bus( size_t capacity = UV_CHANNEL_CAPACITY, overflow_policy policy = overflow_policy::CONFLATE )
+                : capacity( capacity ), policy( policy ), domain( RcuDomain::make_domain()),
+                  routes( new route_table ), route_epoch( 0 ), published( 0 ), dropped( 0 ), conflated( 0 ) {
+                this->route_readers[0].value.store( 0 );
+                this->route_readers[1].value.store( 0 );
+            }
+
+            Bus( const Bus & ) = delete;
+
+            static inline std::shared_ptr<Bus> make_bus( size_t capacity = UV_CHANNEL_CAPACITY,
+                                                         overflow_policy policy = overflow_policy::CONFLATE ) {
+                return std::make_shared<Bus>( capacity, policy );
+            }
+
+            /*
+             * Adds a subscriber that runs on the given loop, from any thread. Returns an id for unsubscribe.
+             *
+             * From another thread, the subscriber is added once the loop gets to it, so anything published before then
+             * may not reach it. The bus has to be made with make_bus for that.
+             * */
+            uint64_t subscribe( std::shared_ptr<Loop> l, const Topic &topic, subscriber_type f ) {
+                uint64_t id;
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    id = this->next_id++;
+
+                    this->pending.insert( id );
+                }
+
+                if( detail::loop_on_thread( l.get())) {
+                    this->add( l, id, topic, std::move( f ));
+
+                } else {
+                    std::weak_ptr<Bus>  weak      = this->shared_from_this();
+                    std::weak_ptr<Loop> weak_loop = l;
+
+                    l->post( [weak, weak_loop, id, topic, f]() mutable {
+                        auto self = weak.lock();
+                        auto loop = weak_loop.lock();
+
+                        if( self && loop ) {
+                            self->add( loop, id, topic, std::move( f ));
+                        }
+                    } );
+                }
+
+                return id;
+            }
+
+            bool unsubscribe( uint64_t id ) {
+                std::lock_guard<std::mutex> lock( this->mutex );
+
+                if( this->pending.erase( id ) != 0 ) {
+                    return true;
+                }
+
+                auto it = this->ids.find( id );
+
+                if( it == this->ids.end()) {
+                    return false;
+                }
+
+                std::shared_ptr<Node> node  = it->second.first;
+                Topic                 topic = it->second.second;
+
+                this->ids.erase( it );
+
+                std::unique_ptr<sub_table> next( new sub_table( *node->subs ));
+
+                auto &list = ( *next )[topic];
+
+                list.erase( std::remove_if( list.begin(), list.end(), [id]( const Subscriber &s ) {
+                    return s.id == id;
+                } ), list.end());
+
+                bool last = list.empty();
+
+                if( last ) {
+                    next->erase( topic );
+                }
+
+                node->subs.publish( std::move( next ));
+
+                if( last ) {
+                    this->update_routes( topic, node, false );
+                }
+
+                return true;
+            }
+
+            /*
+             * Publishes a payload from any thread. Every loop with subscribers to the topic gets one reference to it.
+             * */
+            void publish( const Topic &topic, payload_ptr payload ) {
+                RouteReader reader( this );
+
+                const route_table *table = reader.table;
+
+                this->published.fetch_add( 1, std::memory_order_relaxed );
+
+                auto it = table->find( topic );
+
+                if( it == table->end()) {
+                    return;
+                }
+
+                for( const std::shared_ptr<Node> &node : it->second ) {
+                    //While conflated payloads are waiting, newer ones have to wait behind them to keep their order
+                    if( node->has_overflow.load( std::memory_order_acquire ) || !node->channel->push( Delivery{ topic, payload } )) {
+                        this->overflow( node, topic, payload );
+                    }
+                }
+            }
+
+            template <typename... Args>
+            inline void emplace( const Topic &topic, Args &&... args ) {
+                this->publish( topic, std::make_shared<const Payload>( std::forward<Args>( args )... ));
+            }
+
+            Stats stats() const noexcept {
+                return Stats{ this->published.load( std::memory_order_relaxed ),
+                              this->dropped.load( std::memory_order_relaxed ),
+                              this->conflated.load( std::memory_order_relaxed ) };
+            }
+
+            ~Bus() {
+                for( auto &n : this->nodes ) {
+                    n.second->channel->close( [] {} );
+                }
+
+                delete this->routes.load();
+            }
+    };
+}
+
+#endif //UV_BUS_HPP
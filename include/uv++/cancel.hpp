@@ -0,0 +1,184 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_CANCEL_HPP
+#define UV_CANCEL_HPP
+
+#include "fwd.hpp"
+#include "exception.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace uv {
+    namespace detail {
+        class CancelState {
+            protected:
+                std::atomic_int reason;
+
+                std::mutex                                            mutex;
+                std::unordered_map<uint64_t, std::function<void( int )>> callbacks;
+                uint64_t                                              next_id = 1;
+
+            public:
+                inline CancelState() noexcept
+                    : reason( 0 ) {
+                }
+
+                inline int get() const noexcept {
+                    return this->reason.load( std::memory_order_acquire );
+                }
+
+                /*
+                 * Returns an id for unsubscribe, or zero if it's cancelled already, in which case the callback has
+                 * been run right away.
+                 * */
+                uint64_t subscribe( std::function<void( int )> f ) {
+                    {
+                        std::lock_guard<std::mutex> lock( this->mutex );
+
+                        if( this->get() == 0 ) {
+                            uint64_t id = this->next_id++;
+
+                            this->callbacks.emplace( id, std::move( f ));
+
+                            return id;
+                        }
+                    }
+
+                    f( this->get());
+
+                    return 0;
+                }
+
+                void unsubscribe( uint64_t id ) {
+                    if( id != 0 ) {
+                        std::lock_guard<std::mutex> lock( this->mutex );
+
+                        this->callbacks.erase( id );
+                    }
+                }
+
+                //Only the first call does anything. Callbacks are run on the calling thread, without the lock held.
+                bool cancel( int r ) {
+                    std::unordered_map<uint64_t, std::function<void( int )>> cbs;
+
+                    {
+                        std::lock_guard<std::mutex> lock( this->mutex );
+
+                        int expected = 0;
+
+                        if( !this->reason.compare_exchange_strong( expected, r, std::memory_order_acq_rel )) {
+                            return false;
+                        }
+
+                        cbs.swap( this->callbacks );
+                    }
+
+                    for( auto &cb : cbs ) {
+                        cb.second( r );
+                    }
+
+                    return true;
+                }
+        };
+
+        class DeadlineQueue;
+    }
+
+    /*
+     * Cancels whatever operations it's been given to, from any thread.
+     *
+     * Operations that haven't started yet are dropped, libuv requests are cancelled with uv_cancel where they still
+     * can be, and their futures fail with a ::uv::Exception carrying the reason, UV_ECANCELED unless given otherwise.
+     * Operations that are already running carry on and finish normally.
+     *
+     * Copies share the same state. A default constructed token can never be cancelled, and costs nothing to pass along.
+     * */
+    class CancellationToken {
+        protected:
+            std::shared_ptr<detail::CancelState> state;
+
+            inline explicit CancellationToken( std::shared_ptr<detail::CancelState> s ) noexcept
+                : state( std::move( s )) {
+            }
+
+        public:
+            CancellationToken() noexcept = default;
+
+            static inline CancellationToken make() {
+                return CancellationToken( std::make_shared<detail::CancelState>());
+            }
+
+            inline bool can_be_cancelled() const noexcept {
+                return bool( this->state );
+            }
+
+            inline bool cancel( int reason = UV_ECANCELED ) {
+                assert( reason < 0 );
+
+                return this->state && this->state->cancel( reason );
+            }
+
+            inline bool is_cancelled() const noexcept {
+                return this->state && this->state->get() != 0;
+            }
+
+            //Zero if not cancelled
+            inline int reason() const noexcept {
+                return this->state ? this->state->get() : 0;
+            }
+
+            inline void throw_if_cancelled() const {
+                if( this->is_cancelled()) {
+                    throw ::uv::Exception( this->reason());
+                }
+            }
+
+            /*
+             * For operations that can be cancelled. The callback is run with the reason on whichever thread cancels,
+             * or right away if it's cancelled already, in which case zero is returned instead of an id.
+             * */
+            inline uint64_t subscribe( std::function<void( int )> f ) const {
+                return this->state ? this->state->subscribe( std::move( f )) : 0;
+            }
+
+            inline void unsubscribe( uint64_t id ) const {
+                if( this->state ) {
+                    this->state->unsubscribe( id );
+                }
+            }
+    };
+
+    /*
+     * A token that cancels itself with UV_ETIMEDOUT once the time is up, and can still be cancelled early.
+     *
+     * All deadlines on a loop share a single heap and timer, which is only ever armed for the earliest one.
+     * */
+    class Deadline : public CancellationToken {
+        public:
+            typedef std::chrono::steady_clock::time_point time_point;
+
+        protected:
+            time_point when;
+
+        public:
+            inline Deadline( std::shared_ptr<Loop> l, time_point t );
+
+            template <typename _Rep, typename _Period>
+            inline Deadline( std::shared_ptr<Loop> l, const std::chrono::duration<_Rep, _Period> &timeout )
+                : Deadline( std::move( l ), std::chrono::steady_clock::now() +
+                                            std::chrono::duration_cast<std::chrono::steady_clock::duration>( timeout )) {
+            }
+
+            inline time_point expiry() const noexcept {
+                return this->when;
+            }
+    };
+}
+
+#endif //UV_CANCEL_HPP
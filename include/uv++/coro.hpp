@@ -0,0 +1,262 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_CORO_HPP
+#define UV_CORO_HPP
+
+#include "loop.hpp"
+
+#ifdef UV_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/*
+ * Coroutine support, for compilers with C++20 coroutines.
+ *
+ * uv::task<T> is a lazy coroutine that starts when it's awaited, and hands its result straight back to whoever awaited
+ * it. Inside one, the awaiters from Loop and Filesystem resume right from the libuv callbacks:
+ *
+ *      co_await loop->schedule();                   //Carry on on the loop thread
+ *      co_await loop->sleep( 10ms );                //Timer
+ *      int x = co_await loop->queue_work( f, 21 );  //Over to the thread-pool and back
+ *      Stat s = co_await loop->fs()->co_stat( path );
+ *
+ * None of them go through std::future, and their libuv requests live in the coroutine frame, which comes from the
+ * loop's frame pool. uv::co_spawn starts a task on a loop and gives back a uv::Future for its result.
+ * */
+
+namespace uv {
+    template <typename T = void>
+    class task;
+
+    namespace detail {
+        struct TaskPromiseBase {
+            std::coroutine_handle<> continuation;
+
+            //Resumes whoever was waiting on the task, without growing the stack
+            struct FinalAwaiter {
+                inline bool await_ready() const noexcept {
+                    return false;
+                }
+
+                template <typename Promise>
+                inline std::coroutine_handle<> await_suspend( std::coroutine_handle<Promise> h ) const noexcept {
+                    std::coroutine_handle<> c = h.promise().continuation;
+
+                    return c ? c : std::noop_coroutine();
+                }
+
+                inline void await_resume() const noexcept {
+                }
+            };
+
+            inline std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            inline FinalAwaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            static inline void *operator new( size_t n ) {
+                return FramePool::allocate( n );
+            }
+
+            static inline void operator delete( void *p ) noexcept {
+                FramePool::deallocate( p );
+            }
+        };
+
+        template <typename T>
+        struct TaskPromise : TaskPromiseBase {
+            Outcome<T> outcome;
+
+            inline task<T> get_return_object() noexcept;
+
+            template <typename U>
+            inline void return_value( U &&u ) {
+                this->outcome.set_value( std::forward<U>( u ));
+            }
+
+            inline void unhandled_exception() noexcept {
+                this->outcome.set_exception( std::current_exception());
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : TaskPromiseBase {
+            Outcome<void> outcome;
+
+            inline task<void> get_return_object() noexcept;
+
+            inline void return_void() noexcept {
+                this->outcome.set_value();
+            }
+
+            inline void unhandled_exception() noexcept {
+                this->outcome.set_exception( std::current_exception());
+            }
+        };
+
+        //Fire and forget coroutine, used to drive a task for co_spawn
+        struct DetachedTask {
+            struct promise_type {
+                inline DetachedTask get_return_object() const noexcept {
+                    return {};
+                }
+
+                inline std::suspend_never initial_suspend() const noexcept {
+                    return {};
+                }
+
+                inline std::suspend_never final_suspend() const noexcept {
+                    return {};
+                }
+
+                inline void return_void() const noexcept {
+                }
+
+                inline void unhandled_exception() const noexcept {
+                    std::terminate();
+                }
+
+                static inline void *operator new( size_t n ) {
+                    return FramePool::allocate( n );
+                }
+
+                static inline void operator delete( void *p ) noexcept {
+                    FramePool::deallocate( p );
+                }
+            };
+        };
+    }
+
+    template <typename T>
+    class task {
+        public:
+            typedef detail::TaskPromise<T> promise_type;
+            typedef T                      value_type;
+
+        protected:
+            std::coroutine_handle<promise_type> h;
+
+        public:
+            inline explicit task( std::coroutine_handle<promise_type> h ) noexcept
+                : h( h ) {
+            }
+
+            inline task( task &&other ) noexcept
+                : h( std::exchange( other.h, nullptr )) {
+            }
+
+            task( const task & ) = delete;
+
+            inline task &operator=( task &&other ) noexcept {
+                if( this != &other ) {
+                    if( this->h ) {
+                        this->h.destroy();
+                    }
+
+                    this->h = std::exchange( other.h, nullptr );
+                }
+
+                return *this;
+            }
+
+            inline bool valid() const noexcept {
+                return bool( this->h );
+            }
+
+            /*
+             * Awaiting a task starts it, and the awaiting coroutine is resumed by symmetric transfer once it's done,
+             * on whichever thread the task finished on.
+             * */
+            struct Awaiter {
+                std::coroutine_handle<promise_type> h;
+
+                inline bool await_ready() const noexcept {
+                    return !this->h || this->h.done();
+                }
+
+                inline std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiting ) const noexcept {
+                    this->h.promise().continuation = awaiting;
+
+                    return this->h;
+                }
+
+                inline T await_resume() {
+                    if( !this->h ) {
+                        throw std::future_error( std::future_errc::no_state );
+                    }
+
+                    return this->h.promise().outcome.take();
+                }
+            };
+
+            inline Awaiter operator co_await() && noexcept {
+                return Awaiter{ this->h };
+            }
+
+            inline Awaiter operator co_await() & noexcept {
+                return Awaiter{ this->h };
+            }
+
+            ~task() {
+                if( this->h ) {
+                    this->h.destroy();
+                }
+            }
+    };
+
+    namespace detail {
+        template <typename T>
+        inline task<T> TaskPromise<T>::get_return_object() noexcept {
+            return task<T>( std::coroutine_handle<TaskPromise<T>>::from_promise( *this ));
+        }
+
+        inline task<void> TaskPromise<void>::get_return_object() noexcept {
+            return task<void>( std::coroutine_handle<TaskPromise<void>>::from_promise( *this ));
+        }
+
+        template <typename T>
+        DetachedTask drive_task( std::shared_ptr<Loop> l, task<T> t, Promise<T> p ) {
+            co_await l->schedule();
+
+            try {
+                if constexpr( std::is_void<T>::value ) {
+                    co_await std::move( t );
+
+                    p.set_value();
+
+                } else {
+                    p.set_value( co_await std::move( t ));
+                }
+
+            } catch( ... ) {
+                p.set_exception( std::current_exception());
+            }
+        }
+    }
+
+    /*
+     * Starts a task on the loop thread, and returns a future for its result, which can be chained with then() or
+     * waited on from another thread.
+     * */
+    template <typename T>
+    inline Future<T> co_spawn( std::shared_ptr<Loop> l, task<T> t ) {
+        Promise<T> p;
+
+        Future<T> f = p.get_future();
+
+        detail::drive_task( std::move( l ), std::move( t ), std::move( p ));
+
+        return f;
+    }
+}
+
+#endif //UV_HAS_COROUTINES
+
+#endif //UV_CORO_HPP
@@ -11,6 +11,16 @@
 # error "This library requires C++14 or higher."
 #endif
 
+/*
+ * Coroutine support is only enabled when the compiler has it, so everything else keeps working as C++14.
+ * Define UV_NO_COROUTINES to leave it out regardless.
+ * */
+#if !defined( UV_NO_COROUTINES ) && defined( __cpp_impl_coroutine ) && defined( __has_include )
+# if __has_include( <coroutine> )
+#  define UV_HAS_COROUTINES
+# endif
+#endif
+
 #include <uv.h>
 #include <fcntl.h>
 #include <cassert>
@@ -25,16 +35,28 @@
 # define UV_WRITE_BUFFER_SIZE 16384 //16k
 #endif
 
+#ifndef UV_CHANNEL_CAPACITY
+# define UV_CHANNEL_CAPACITY 1024
+#endif
+
+#ifndef UV_ACTOR_MAILBOX_CAPACITY
+# define UV_ACTOR_MAILBOX_CAPACITY 256
+#endif
+
+/*
+ * Work queued on a loop is let into the libuv thread-pool highest priority first, but every this many times, whatever
+ * has waited longest goes next instead, so lower priorities always get a share.
+ * */
+#ifndef UV_WORK_FAIR_SHARE
+# define UV_WORK_FAIR_SHARE 8
+#endif
+
 #ifdef UV_USE_BOOST_LOCKFREE
 # ifndef UV_LOCKFREE_QUEUE_SIZE
 #  define UV_LOCKFREE_QUEUE_SIZE 128
 # endif
 #endif
 
-#ifndef UV_ASYNC_LAUNCH
-# define UV_ASYNC_LAUNCH ::std::launch::deferred
-#endif
-
 #ifdef UV_DOXYGEN
 # define UV_DECLTYPE_AUTO auto
 #else
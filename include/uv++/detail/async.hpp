@@ -10,12 +10,17 @@
 
 namespace uv {
     namespace detail {
+        /*
+         * The result can be a std::promise, or anything else with the same set_value and set_exception members
+         * */
         template <typename R>
         struct dispatch_helper {
-            template <typename Functor, typename... Args>
-            static inline void dispatch( std::promise<R> &result, Functor f, std::tuple<Args...> &&args ) noexcept {
+            template <typename Result, typename Functor, typename Tuple>
+            static inline void dispatch( Result &result, Functor &f, Tuple &&args ) noexcept {
+                typedef typename function_traits<Functor>::tuple_type params;
+
                 try {
-                    result.set_value( invoke( f, args ));
+                    result.set_value( invoke_stored<params>( f, args ));
 
                 } catch( ... ) {
                     result.set_exception( std::current_exception());
@@ -25,10 +30,12 @@ namespace uv {
 
         template <>
         struct dispatch_helper<void> {
-            template <typename Functor, typename... Args>
-            static inline void dispatch( std::promise<void> &result, Functor f, std::tuple<Args...> &&args ) noexcept {
+            template <typename Result, typename Functor, typename Tuple>
+            static inline void dispatch( Result &result, Functor &f, Tuple &&args ) noexcept {
+                typedef typename function_traits<Functor>::tuple_type params;
+
                 try {
-                    invoke( f, args );
+                    invoke_stored<params>( f, args );
 
                     result.set_value();
 
@@ -38,16 +45,123 @@ namespace uv {
             }
         };
 
+        /*
+         * For when nobody is waiting on the result. There's nowhere to report an exception to,
+         * so it's dropped rather than let it unwind through libuv.
+         * */
+        template <typename Functor, typename Tuple>
+        inline void dispatch_nowait( Functor &f, Tuple &&args ) noexcept {
+            typedef typename function_traits<Functor>::tuple_type params;
+
+            try {
+                invoke_stored<params>( f, args );
+
+            } catch( ... ) {
+            }
+        }
+
+        /*
+         * Holds a result until it can be handed over to a promise, so the result can be produced on one thread and
+         * the promise satisfied later on another.
+         * */
+        template <typename T>
+        struct Outcome {
+            typename std::aligned_storage<sizeof( T ), alignof( T )>::type storage;
+
+            std::exception_ptr error;
+
+            bool has_value = false;
+
+            inline T &value() noexcept {
+                return *reinterpret_cast<T *>(&this->storage);
+            }
+
+            template <typename... Args>
+            inline void set_value( Args &&... args ) {
+                new( &this->storage ) T( std::forward<Args>( args )... );
+
+                this->has_value = true;
+            }
+
+            inline void set_exception( std::exception_ptr e ) noexcept {
+                this->error = e;
+            }
+
+            inline bool empty() const noexcept {
+                return !this->has_value && !this->error;
+            }
+
+            inline void deliver( std::promise<T> &p ) {
+                if( this->error ) {
+                    p.set_exception( this->error );
+
+                } else {
+                    p.set_value( std::move( this->value()));
+                }
+            }
+
+            //Moves the result out, or throws the exception
+            inline T take() {
+                if( this->error ) {
+                    std::rethrow_exception( this->error );
+                }
+
+                return std::move( this->value());
+            }
+
+            ~Outcome() {
+                if( this->has_value ) {
+                    this->value().~T();
+                }
+            }
+        };
+
+        template <>
+        struct Outcome<void> {
+            std::exception_ptr error;
+
+            bool has_value = false;
+
+            inline void set_value() noexcept {
+                this->has_value = true;
+            }
+
+            inline void set_exception( std::exception_ptr e ) noexcept {
+                this->error = e;
+            }
+
+            inline bool empty() const noexcept {
+                return !this->has_value && !this->error;
+            }
+
+            inline void deliver( std::promise<void> &p ) {
+                if( this->error ) {
+                    p.set_exception( this->error );
+
+                } else {
+                    p.set_value();
+                }
+            }
+
+            inline void take() {
+                if( this->error ) {
+                    std::rethrow_exception( this->error );
+                }
+            }
+        };
+
         template <typename Functor, typename Self>
         struct AsyncContinuationBase : public Continuation<Functor, Self> {
             typedef typename detail::function_traits<Functor>::result_type result_type;
-            typedef typename detail::function_traits<Functor>::tuple_type  tuple_type;
+
+            //Arguments are stored by value until the functor is invoked
+            typedef typename decay_tuple<typename detail::function_traits<Functor>::tuple_type>::type tuple_type;
 
             std::unique_ptr<std::promise<result_type>>       r;
             std::unique_ptr<std::shared_future<result_type>> s;
 
             inline AsyncContinuationBase( Functor f ) noexcept
-                : Continuation<Functor, Self>( f ) {
+                : Continuation<Functor, Self>( std::move( f )) {
             }
 
             inline std::shared_future<result_type> base_init() {
@@ -66,13 +180,13 @@ namespace uv {
             typedef typename AsyncContinuationBase<Functor, Self>::result_type result_type;
 
             inline AsyncContinuation( Functor f ) noexcept
-                : AsyncContinuationBase<Functor, Self>( f ) {
+                : AsyncContinuationBase<Functor, Self>( std::move( f )) {
             }
 
             std::unique_ptr<tuple_type> p;
 
             inline void dispatch() {
-                dispatch_helper<result_type>::dispatch( *this->r, this->f, std::move( *this->p ));
+                dispatch_helper<result_type>::dispatch( *this->r, this->f, *this->p );
 
                 this->cleanup();
             }
@@ -97,25 +211,37 @@ namespace uv {
                 this->p.reset();
             }
 
+            //Stores the arguments for later, without setting up a result
             template <typename T, typename... Args>
             inline typename std::enable_if<
                 std::is_same<T, Self>::value &&
-                ContinuationNeedsSelf<Functor, T>::value, std::shared_future<result_type>>::type
-            init( std::shared_ptr<T> &&self, Args &&... args ) {
+                ContinuationNeedsSelf<Functor, T>::value>::type
+            store_args( std::shared_ptr<T> &&self, Args &&... args ) {
                 this->p = std::make_unique<tuple_type>( std::move( self ), std::forward<Args>( args )... );
-
-                return this->base_init();
             }
 
             template <typename T, typename... Args>
             inline typename std::enable_if<
                 std::is_same<T, Self>::value &&
-                !ContinuationNeedsSelf<Functor, T>::value, std::shared_future<result_type>>::type
-            init( std::shared_ptr<T> &&, Args &&... args ) {
+                !ContinuationNeedsSelf<Functor, T>::value>::type
+            store_args( std::shared_ptr<T> &&, Args &&... args ) {
                 this->p = std::make_unique<tuple_type>( std::forward<Args>( args )... );
+            }
+
+            template <typename T, typename... Args>
+            inline std::shared_future<result_type> init( std::shared_ptr<T> &&self, Args &&... args ) {
+                this->store_args( std::move( self ), std::forward<Args>( args )... );
 
                 return this->base_init();
             }
+
+            //Runs the functor with the stored arguments, into any result type
+            template <typename Result>
+            inline void invoke_into( Result &result ) {
+                dispatch_helper<result_type>::dispatch( result, this->f, *this->p );
+
+                this->p.reset();
+            }
         };
 
         template <typename Functor, typename Self>
@@ -126,11 +252,13 @@ namespace uv {
             typedef ContinuationNeedsSelf<Functor, Self> needs_self;
 
             inline AsyncContinuation( Functor f ) noexcept
-                : AsyncContinuationBase<Functor, Self>( f ) {
+                : AsyncContinuationBase<Functor, Self>( std::move( f )) {
             }
 
             inline void dispatch() {
-                dispatch_helper<result_type>::dispatch( *this->r, this->f, tuple_type());
+                tuple_type empty;
+
+                dispatch_helper<result_type>::dispatch( *this->r, this->f, empty );
 
                 this->cleanup();
             }
@@ -154,10 +282,21 @@ namespace uv {
                 this->s.reset();
             }
 
-            template <typename T, typename... Args>
+            template <typename T>
+            inline void store_args( std::shared_ptr<T> && ) {
+            }
+
+            template <typename T>
             inline std::shared_future<result_type> init( std::shared_ptr<T> && ) {
                 return this->base_init();
             }
+
+            template <typename Result>
+            inline void invoke_into( Result &result ) {
+                tuple_type empty;
+
+                dispatch_helper<result_type>::dispatch( result, this->f, empty );
+            }
         };
     }
 }
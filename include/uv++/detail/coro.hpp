@@ -0,0 +1,466 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_CORO_DETAIL_HPP
+#define UV_CORO_DETAIL_HPP
+
+#include "../fwd.hpp"
+
+#ifdef UV_HAS_COROUTINES
+
+#include "async.hpp"
+#include "../requests/fs.hpp"
+
+#include <coroutine>
+#include <atomic>
+#include <tuple>
+#include <thread>
+
+#ifndef UV_FRAME_POOL_GRANULARITY
+# define UV_FRAME_POOL_GRANULARITY 64
+#endif
+
+#ifndef UV_FRAME_POOL_CLASSES
+# define UV_FRAME_POOL_CLASSES 32 //Frames up to 2k are pooled
+#endif
+
+namespace uv {
+    namespace detail {
+        /*
+         * Coroutine frames for each loop come from size classes in a pool owned by that loop.
+         *
+         * Frames are allocated and mostly freed on the loop thread, where the free lists need no synchronization.
+         * Frames freed on any other thread are pushed onto a lock-free list for their class, and the loop takes the
+         * whole list back the next time its own list runs dry.
+         *
+         * Every outstanding frame holds a reference, so the pool outlives its loop if it has to.
+         * */
+        class FramePool {
+            protected:
+                struct Block {
+                    Block *next;
+                };
+
+                //Sits in front of every frame, so it can be returned to the right place
+                struct alignas( alignof( std::max_align_t )) Header {
+                    FramePool *pool;
+                    size_t    cls;
+                };
+
+                static constexpr size_t UNPOOLED = SIZE_MAX;
+
+                Block               *local[UV_FRAME_POOL_CLASSES] = {};
+                std::atomic<Block *> remote[UV_FRAME_POOL_CLASSES] = {};
+
+                std::atomic<size_t> refs;
+
+                //Keeps the pool alive while it's current for a thread
+                struct Current {
+                    FramePool *pool = nullptr;
+
+                    inline void set( FramePool *p ) noexcept {
+                        if( p != nullptr ) {
+                            p->add_ref();
+                        }
+
+                        if( this->pool != nullptr ) {
+                            this->pool->release();
+                        }
+
+                        this->pool = p;
+                    }
+
+                    ~Current() {
+                        this->set( nullptr );
+                    }
+                };
+
+                static inline Current &current_slot() noexcept {
+                    static thread_local Current c;
+
+                    return c;
+                }
+
+                inline void add_ref() noexcept {
+                    this->refs.fetch_add( 1, std::memory_order_relaxed );
+                }
+
+                void *take( size_t cls ) noexcept {
+                    Block *b = this->local[cls];
+
+                    if( b == nullptr ) {
+                        b = this->remote[cls].exchange( nullptr, std::memory_order_acquire );
+                    }
+
+                    if( b != nullptr ) {
+                        this->local[cls] = b->next;
+                    }
+
+                    return b;
+                }
+
+                void give( size_t cls, void *p ) noexcept {
+                    Block *b = static_cast<Block *>(p);
+
+                    if( current() == this ) {
+                        b->next = this->local[cls];
+
+                        this->local[cls] = b;
+
+                    } else {
+                        b->next = this->remote[cls].load( std::memory_order_relaxed );
+
+                        while( !this->remote[cls].compare_exchange_weak( b->next, b, std::memory_order_release, std::memory_order_relaxed )) {
+                        }
+                    }
+                }
+
+                static inline void free_list( Block *b ) noexcept {
+                    while( b != nullptr ) {
+                        Block *next = b->next;
+
+                        ::operator delete( b );
+
+                        b = next;
+                    }
+                }
+
+                ~FramePool() {
+                    for( size_t cls = 0; cls < UV_FRAME_POOL_CLASSES; ++cls ) {
+                        free_list( this->local[cls] );
+                        free_list( this->remote[cls].load( std::memory_order_acquire ));
+                    }
+                }
+
+            public:
+                inline FramePool() noexcept
+                    : refs( 1 ) {
+                }
+
+                FramePool( const FramePool & ) = delete;
+
+                static inline FramePool *current() noexcept {
+                    return current_slot().pool;
+                }
+
+                static inline void make_current( FramePool *p ) noexcept {
+                    if( current() != p ) {
+                        current_slot().set( p );
+                    }
+                }
+
+                /*
+                 * Makes a pool current on this thread only for as long as the loop is running on it, and then puts back
+                 * whatever was current before, in case it's a loop being run from inside another loop's callback.
+                 * */
+                class CurrentScope {
+                    protected:
+                        FramePool *previous;
+
+                    public:
+                        inline explicit CurrentScope( FramePool *p ) noexcept
+                            : previous( current()) {
+                            if( this->previous != nullptr ) {
+                                this->previous->add_ref();
+                            }
+
+                            make_current( p );
+                        }
+
+                        CurrentScope( const CurrentScope & ) = delete;
+
+                        ~CurrentScope() {
+                            make_current( this->previous );
+
+                            if( this->previous != nullptr ) {
+                                this->previous->release();
+                            }
+                        }
+                };
+
+                inline void release() noexcept {
+                    if( this->refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                        delete this;
+                    }
+                }
+
+                static void *allocate( size_t n ) {
+                    FramePool *pool  = current();
+                    size_t    total = n + sizeof( Header );
+                    size_t    cls   = ( total - 1 ) / UV_FRAME_POOL_GRANULARITY;
+
+                    void *p = nullptr;
+
+                    if( pool == nullptr || cls >= UV_FRAME_POOL_CLASSES ) {
+                        pool = nullptr;
+                        cls  = UNPOOLED;
+
+                        p = ::operator new( total );
+
+                    } else {
+                        p = pool->take( cls );
+
+                        if( p == nullptr ) {
+                            p = ::operator new(( cls + 1 ) * UV_FRAME_POOL_GRANULARITY );
+                        }
+
+                        pool->add_ref();
+                    }
+
+                    Header *h = new( p ) Header{ pool, cls };
+
+                    return h + 1;
+                }
+
+                static void deallocate( void *p ) noexcept {
+                    Header *h = static_cast<Header *>(p) - 1;
+
+                    FramePool *pool = h->pool;
+
+                    if( pool == nullptr ) {
+                        ::operator delete( h );
+
+                    } else {
+                        pool->give( h->cls, h );
+
+                        pool->release();
+                    }
+                }
+        };
+
+        //Switches the awaiting coroutine onto the loop thread, if it's not there already
+        struct ScheduleAwaiter {
+            Loop *loop;
+
+            inline bool await_ready() const noexcept {
+                return loop_on_thread( this->loop );
+            }
+
+            inline void await_suspend( std::coroutine_handle<> h ) const {
+                loop_post( this->loop, h.address(), []( void *p ) {
+                    std::coroutine_handle<>::from_address( p ).resume();
+                } );
+            }
+
+            inline void await_resume() const noexcept {
+            }
+        };
+
+        /*
+         * Base for awaiters that have to start something on the loop thread. If the coroutine isn't on the loop, the
+         * start is posted there. The awaiter lives in the suspended coroutine's frame, so libuv can point right at it.
+         * */
+        template <typename Derived>
+        struct LoopAwaiter {
+            Loop                    *loop;
+            std::coroutine_handle<> waiting;
+
+            inline bool await_ready() const noexcept {
+                return false;
+            }
+
+            //Returns false if it finished right away, to carry on without suspending
+            bool await_suspend( std::coroutine_handle<> h ) {
+                this->waiting = h;
+
+                if( loop_on_thread( this->loop )) {
+                    return static_cast<Derived *>(this)->begin();
+                }
+
+                loop_post( this->loop, this, []( void *p ) {
+                    Derived *self = static_cast<Derived *>(p);
+
+                    if( !self->begin()) {
+                        self->waiting.resume();
+                    }
+                } );
+
+                return true;
+            }
+        };
+
+        /*
+         * Sleeps with its own timer in the coroutine frame. The timer has to be closed before the frame can go away,
+         * so the coroutine is resumed from the close callback, which libuv runs in the same loop iteration.
+         * */
+        struct SleepAwaiter : LoopAwaiter<SleepAwaiter> {
+            uv_timer_t timer;
+            uint64_t   timeout;
+
+            inline SleepAwaiter( Loop *l, uint64_t ms ) noexcept
+                : LoopAwaiter<SleepAwaiter>{ l, nullptr }, timeout( ms ) {
+            }
+
+            bool begin() {
+                uv_timer_init( loop_handle( this->loop ), &this->timer );
+
+                this->timer.data = this;
+
+                uv_timer_start( &this->timer, []( uv_timer_t *t ) {
+                    uv_close((uv_handle_t *)t, []( uv_handle_t *h ) {
+                        static_cast<SleepAwaiter *>(h->data)->waiting.resume();
+                    } );
+                }, this->timeout, 0 );
+
+                return true;
+            }
+
+            inline void await_resume() const noexcept {
+            }
+        };
+
+        /*
+         * Hops over to the thread-pool to run the functor, then back to the loop thread with the result, with the
+         * uv_work_t, arguments and result all kept in the coroutine frame.
+         * */
+        template <typename Functor, typename... Args>
+        struct WorkAwaiter : LoopAwaiter<WorkAwaiter<Functor, Args...>> {
+            typedef std::invoke_result_t<Functor &, Args &...> result_type;
+
+            uv_work_t            req;
+            Functor              f;
+            std::tuple<Args...>  args;
+            Outcome<result_type> outcome;
+            int                  status = 0;
+
+            template <typename F, typename... A>
+            inline WorkAwaiter( Loop *l, F &&fn, A &&... a )
+                : LoopAwaiter<WorkAwaiter>{ l, nullptr }, f( std::forward<F>( fn )), args( std::forward<A>( a )... ) {
+            }
+
+            bool begin() {
+                this->req.data = this;
+
+                int res = uv_queue_work( loop_handle( this->loop ), &this->req, []( uv_work_t *w ) {
+                    WorkAwaiter *self = static_cast<WorkAwaiter *>(w->data);
+
+                    try {
+                        if constexpr( std::is_void<result_type>::value ) {
+                            std::apply( self->f, self->args );
+
+                            self->outcome.set_value();
+
+                        } else {
+                            self->outcome.set_value( std::apply( self->f, self->args ));
+                        }
+
+                    } catch( ... ) {
+                        self->outcome.set_exception( std::current_exception());
+                    }
+
+                }, []( uv_work_t *w, int status ) {
+                    WorkAwaiter *self = static_cast<WorkAwaiter *>(w->data);
+
+                    self->status = status;
+
+                    self->waiting.resume();
+                } );
+
+                if( res < 0 ) {
+                    this->status = res;
+
+                    return false;
+                }
+
+                return true;
+            }
+
+            result_type await_resume() {
+                if( this->status != 0 ) {
+                    throw ::uv::Exception( this->status );
+                }
+
+                return this->outcome.take();
+            }
+        };
+
+        /*
+         * Runs any uv_fs_* function with the request in the coroutine frame, and resumes straight from the fs callback.
+         * The transform turns the finished request into the result there, and negative results are thrown as
+         * exceptions. Strings are kept by value in the frame until the request is made.
+         * */
+        template <typename Transform, typename Functor, typename... Args>
+        struct FsAwaiter : LoopAwaiter<FsAwaiter<Transform, Functor, Args...>> {
+            typedef std::invoke_result_t<Transform &, uv_fs_t *> result_type;
+
+            uv_fs_t              req;
+            Transform            transform;
+            Functor              uf;
+            std::tuple<Args...>  args;
+            Outcome<result_type> outcome;
+            ssize_t              result = 0;
+
+            template <typename... A>
+            inline FsAwaiter( Loop *l, Transform t, Functor fn, A &&... a )
+                : LoopAwaiter<FsAwaiter>{ l, nullptr }, transform( std::move( t )), uf( fn ), args( std::forward<A>( a )... ) {
+            }
+
+            void finish() {
+                this->result = this->req.result;
+
+                if( this->result >= 0 ) {
+                    try {
+                        if constexpr( std::is_void<result_type>::value ) {
+                            this->transform( &this->req );
+
+                            this->outcome.set_value();
+
+                        } else {
+                            this->outcome.set_value( this->transform( &this->req ));
+                        }
+
+                    } catch( ... ) {
+                        this->outcome.set_exception( std::current_exception());
+                    }
+                }
+
+                uv_fs_req_cleanup( &this->req );
+            }
+
+            bool begin() {
+                this->req.data = this;
+
+                int res = std::apply( [this]( Args &... a ) {
+                    return this->uf( loop_handle( this->loop ), &this->req, fs_arg( a )..., []( uv_fs_t *r ) {
+                        FsAwaiter *self = static_cast<FsAwaiter *>(r->data);
+
+                        self->finish();
+
+                        self->waiting.resume();
+                    } );
+                }, this->args );
+
+                //Failing to even start the request means the callback never runs
+                if( res < 0 ) {
+                    uv_fs_req_cleanup( &this->req );
+
+                    this->result = res;
+
+                    return false;
+                }
+
+                return true;
+            }
+
+            result_type await_resume() {
+                if( this->result < 0 ) {
+                    throw ::uv::Exception((int)this->result );
+                }
+
+                return this->outcome.take();
+            }
+        };
+
+        //Just the result of the request, like the number of bytes read or the new file descriptor
+        struct FsResultTransform {
+            inline ssize_t operator()( uv_fs_t *req ) const noexcept {
+                return req->result;
+            }
+        };
+    }
+}
+
+#endif //UV_HAS_COROUTINES
+
+#endif //UV_CORO_DETAIL_HPP
@@ -0,0 +1,239 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_FIBER_DETAIL_HPP
+#define UV_FIBER_DETAIL_HPP
+
+#include "../fwd.hpp"
+
+#ifdef __linux__
+
+#include "../future.hpp"
+
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <cerrno>
+#include <unistd.h>
+
+#include <vector>
+
+#ifndef UV_FIBER_STACK_SIZE
+# define UV_FIBER_STACK_SIZE 131072 //128k, only committed as it's touched
+#endif
+
+#ifndef UV_FIBER_STACK_CACHE
+# define UV_FIBER_STACK_CACHE 256
+#endif
+
+namespace uv {
+    namespace detail {
+        class FiberHost;
+
+        struct Fiber {
+            ucontext_t ctx;
+            ucontext_t caller;
+            FiberHost  *host  = nullptr;
+            char       *stack = nullptr;
+            bool       done   = false;
+
+            //Runs the fiber's functor. Has to catch everything, since there's nowhere for exceptions to go.
+            void (*entry)( Fiber * ) = nullptr;
+
+            virtual ~Fiber() = default;
+        };
+
+        template <typename Functor, typename R>
+        struct FiberTask final : Fiber {
+            Functor    f;
+            Promise<R> promise;
+
+            inline explicit FiberTask( Functor &&fn )
+                : f( std::move( fn )) {
+                this->entry = []( Fiber *fb ) {
+                    FiberTask *self = static_cast<FiberTask *>(fb);
+
+                    try {
+                        self->promise.set_value( self->f());
+
+                    } catch( ... ) {
+                        self->promise.set_exception( std::current_exception());
+                    }
+                };
+            }
+        };
+
+        template <typename Functor>
+        struct FiberTask<Functor, void> final : Fiber {
+            Functor       f;
+            Promise<void> promise;
+
+            inline explicit FiberTask( Functor &&fn )
+                : f( std::move( fn )) {
+                this->entry = []( Fiber *fb ) {
+                    FiberTask *self = static_cast<FiberTask *>(fb);
+
+                    try {
+                        self->f();
+
+                        self->promise.set_value();
+
+                    } catch( ... ) {
+                        self->promise.set_exception( std::current_exception());
+                    }
+                };
+            }
+        };
+
+        /*
+         * Runs fibers for a single loop, on its thread.
+         *
+         * Each fiber gets an mmap'd stack with a guard page below it, so overflowing it faults instead of corrupting
+         * whatever is next to it. Pages are only committed as they're touched, so thousands of mostly idle fibers
+         * only cost what they actually use, and stacks are kept around for reuse once their fibers finish.
+         *
+         * Fibers are only ever resumed from the loop thread, either straight from a libuv callback or through
+         * Loop::post when something completes on another thread.
+         * */
+        class FiberHost {
+            protected:
+                Loop   *loop;
+                size_t page_size;
+                size_t stack_size;
+
+                std::vector<char *> stacks;
+
+                static inline Fiber *&current_slot() noexcept {
+                    static thread_local Fiber *f = nullptr;
+
+                    return f;
+                }
+
+                char *take_stack() {
+                    if( !this->stacks.empty()) {
+                        char *s = this->stacks.back();
+
+                        this->stacks.pop_back();
+
+                        return s;
+                    }
+
+                    void *p = mmap( nullptr, this->stack_size + this->page_size, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0 );
+
+                    if( p == MAP_FAILED ) {
+                        throw ::uv::Exception( UV_ENOMEM );
+                    }
+
+                    //Stacks grow down, so the guard goes at the bottom
+                    if( mprotect( p, this->page_size, PROT_NONE ) != 0 ) {
+                        int err = -errno;
+
+                        munmap( p, this->stack_size + this->page_size );
+
+                        throw ::uv::Exception( err );
+                    }
+
+                    return static_cast<char *>(p);
+                }
+
+                void give_stack( char *s ) noexcept {
+                    if( this->stacks.size() < UV_FIBER_STACK_CACHE ) {
+                        this->stacks.push_back( s );
+
+                    } else {
+                        munmap( s, this->stack_size + this->page_size );
+                    }
+                }
+
+                static void trampoline() {
+                    Fiber *f = current();
+
+                    f->entry( f );
+
+                    f->done = true;
+
+                    //Never comes back here, since the fiber is deleted once it's done
+                    swapcontext( &f->ctx, &f->caller );
+                }
+
+            public:
+                inline explicit FiberHost( Loop *l )
+                    : loop( l ), page_size((size_t)sysconf( _SC_PAGESIZE )) {
+                    this->stack_size = ( UV_FIBER_STACK_SIZE + this->page_size - 1 ) / this->page_size * this->page_size;
+                }
+
+                FiberHost( const FiberHost & ) = delete;
+
+                //The fiber running on this thread, if any
+                static inline Fiber *current() noexcept {
+                    return current_slot();
+                }
+
+                //Sets up the fiber's stack and runs it until it first suspends
+                void start( Fiber *f ) {
+                    f->host  = this;
+                    f->stack = this->take_stack();
+
+                    getcontext( &f->ctx );
+
+                    f->ctx.uc_stack.ss_sp   = f->stack + this->page_size;
+                    f->ctx.uc_stack.ss_size = this->stack_size;
+                    f->ctx.uc_link          = nullptr;
+
+                    makecontext( &f->ctx, &FiberHost::trampoline, 0 );
+
+                    this->resume( f );
+                }
+
+                //Switches to the fiber until it suspends or finishes, on the loop thread
+                void resume( Fiber *f ) {
+                    Fiber *prev = current_slot();
+
+                    current_slot() = f;
+
+                    swapcontext( &f->caller, &f->ctx );
+
+                    current_slot() = prev;
+
+                    if( f->done ) {
+                        this->give_stack( f->stack );
+
+                        delete f;
+                    }
+                }
+
+                //From any thread
+                void post_resume( Fiber *f ) {
+                    loop_post( this->loop, f, []( void *p ) {
+                        Fiber *fb = static_cast<Fiber *>(p);
+
+                        fb->host->resume( fb );
+                    } );
+                }
+
+                //Switches the current fiber back to whatever resumed it. Something has to resume it later.
+                static void suspend() {
+                    Fiber *f = current();
+
+                    assert( f != nullptr );
+
+                    swapcontext( &f->ctx, &f->caller );
+                }
+
+                inline Loop *owner() const noexcept {
+                    return this->loop;
+                }
+
+                ~FiberHost() {
+                    for( char *s : this->stacks ) {
+                        munmap( s, this->stack_size + this->page_size );
+                    }
+                }
+        };
+    }
+}
+
+#endif //__linux__
+
+#endif //UV_FIBER_DETAIL_HPP
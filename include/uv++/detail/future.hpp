@@ -0,0 +1,289 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_FUTURE_DETAIL_HPP
+#define UV_FUTURE_DETAIL_HPP
+
+#include "../exception.hpp"
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace uv {
+    namespace detail {
+        //Stands in for void wherever a value has to be stored
+        struct Unit {
+        };
+
+        /*
+         * Something waiting on a FutureState, like a continuation from then(), a waiter from a blocking get() on the
+         * waiting thread's stack, or one input of a when_all.
+         * */
+        struct FutureNode {
+            void (*run)( FutureNode * );
+
+            FutureNode *next = nullptr;
+        };
+
+        /*
+         * Shared state between a Promise and a Future, in a single allocation with the result stored inline.
+         *
+         * The word is PENDING, READY, or a pointer to the most recently attached FutureNode, which links to the rest.
+         * The promise exchanges it for READY once and runs every node that was there, and waiters push their node
+         * unless it's already READY. Nodes are never removed before that, so nothing needs a lock.
+         * */
+        template <typename T>
+        class FutureState {
+            public:
+                typedef typename std::conditional<std::is_void<T>::value, Unit, T>::type storage_type;
+
+                enum : uintptr_t {
+                    PENDING = 0,
+                    READY   = 1
+                };
+
+            protected:
+                std::atomic<uintptr_t> word;
+                std::atomic<uint32_t>  refs;
+
+                typename std::aligned_storage<sizeof( storage_type ), alignof( storage_type )>::type storage;
+
+                std::exception_ptr error;
+
+                //Failures set with an error code skip the exception_ptr entirely, unless someone asks for one
+                std::error_code ec;
+
+                bool failed = false;
+
+                inline void complete() {
+                    uintptr_t prev = this->word.exchange( READY, std::memory_order_acq_rel );
+
+                    if( prev != READY ) {
+                        FutureNode *n = reinterpret_cast<FutureNode *>(prev);
+
+                        while( n != nullptr ) {
+                            //Running a node may free it
+                            FutureNode *next = n->next;
+
+                            n->run( n );
+
+                            n = next;
+                        }
+                    }
+                }
+
+            public:
+                inline FutureState() noexcept
+                    : word( PENDING ), refs( 1 ) {
+                }
+
+                FutureState( const FutureState & ) = delete;
+
+                inline void add_ref() noexcept {
+                    this->refs.fetch_add( 1, std::memory_order_relaxed );
+                }
+
+                inline void release() noexcept {
+                    if( this->refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                        delete this;
+                    }
+                }
+
+                inline bool is_ready() const noexcept {
+                    return this->word.load( std::memory_order_acquire ) == READY;
+                }
+
+                inline bool has_exception() const noexcept {
+                    return this->failed;
+                }
+
+                inline bool has_error_code() const noexcept {
+                    return this->failed && bool( this->ec );
+                }
+
+                inline const std::error_code &code() const noexcept {
+                    return this->ec;
+                }
+
+                inline std::exception_ptr exception() const {
+                    if( !this->error && this->ec ) {
+                        return make_error_exception( this->ec );
+                    }
+
+                    return this->error;
+                }
+
+                inline storage_type &value() noexcept {
+                    return *reinterpret_cast<storage_type *>(&this->storage);
+                }
+
+                template <typename... Args>
+                inline void set_value( Args &&... args ) {
+                    new( &this->storage ) storage_type( std::forward<Args>( args )... );
+
+                    this->complete();
+                }
+
+                inline void set_exception( std::exception_ptr e ) {
+                    this->error  = e;
+                    this->failed = true;
+
+                    this->complete();
+                }
+
+                inline void set_error( std::error_code e ) {
+                    this->ec     = e;
+                    this->failed = true;
+
+                    this->complete();
+                }
+
+                //Passes on the failure of another state, as an error code if that's what it has
+                template <typename U>
+                inline void fail_from( FutureState<U> *src ) {
+                    if( src->has_error_code()) {
+                        this->set_error( src->code());
+
+                    } else {
+                        this->set_exception( src->exception());
+                    }
+                }
+
+                /*
+                 * Attaches the node to be run once the state is ready. Returns false if it's ready already,
+                 * in which case the node isn't attached and the caller should carry on right away.
+                 * */
+                inline bool attach( FutureNode *n ) noexcept {
+                    uintptr_t head = this->word.load( std::memory_order_acquire );
+
+                    do {
+                        if( head == READY ) {
+                            return false;
+                        }
+
+                        n->next = reinterpret_cast<FutureNode *>(head);
+
+                    } while( !this->word.compare_exchange_weak( head, reinterpret_cast<uintptr_t>(n), std::memory_order_acq_rel, std::memory_order_acquire ));
+
+                    return true;
+                }
+
+                virtual ~FutureState() {
+                    if( this->word.load( std::memory_order_relaxed ) == READY && !this->failed ) {
+                        this->value().~storage_type();
+                    }
+                }
+        };
+
+        //Sets a state from the result of calling a functor, so void results don't need their own code paths everywhere
+        template <typename R>
+        struct future_invoke {
+            template <typename Functor, typename... Args>
+            static inline void apply( FutureState<R> *s, Functor &f, Args &&... args ) {
+                s->set_value( f( std::forward<Args>( args )... ));
+            }
+        };
+
+        template <>
+        struct future_invoke<void> {
+            template <typename Functor, typename... Args>
+            static inline void apply( FutureState<void> *s, Functor &f, Args &&... args ) {
+                f( std::forward<Args>( args )... );
+
+                s->set_value();
+            }
+        };
+
+        //Calls a continuation with the value of the previous future, or nothing for void
+        template <typename T>
+        struct future_result_of {
+            template <typename Functor>
+            using type = decltype( std::declval<Functor &>()( std::declval<T>()));
+        };
+
+        template <>
+        struct future_result_of<void> {
+            template <typename Functor>
+            using type = decltype( std::declval<Functor &>()());
+        };
+
+        template <typename U, typename T>
+        struct future_forward {
+            template <typename Functor>
+            static inline void apply( FutureState<U> *s, Functor &f, FutureState<T> *src ) {
+                future_invoke<U>::apply( s, f, std::move( src->value()));
+            }
+        };
+
+        template <typename U>
+        struct future_forward<U, void> {
+            template <typename Functor>
+            static inline void apply( FutureState<U> *s, Functor &f, FutureState<void> * ) {
+                future_invoke<U>::apply( s, f );
+            }
+        };
+
+        /*
+         * The state of a future returned by then(), which also holds the continuation itself, so chaining a
+         * continuation is still only one allocation.
+         * */
+        template <typename U, typename T, typename Functor, typename Executor>
+        class ThenState final : public FutureState<U>, public FutureNode {
+            protected:
+                Functor        f;
+                Executor       executor;
+                FutureState<T> *src;
+
+                static void invoke( void *p ) {
+                    ThenState      *self = static_cast<ThenState *>(p);
+                    FutureState<T> *src  = self->src;
+
+                    if( src->has_exception()) {
+                        self->fail_from( src );
+
+                    } else {
+                        try {
+                            future_forward<U, T>::apply( self, self->f, src );
+
+                        } catch( ... ) {
+                            self->set_exception( std::current_exception());
+                        }
+                    }
+
+                    self->src = nullptr;
+
+                    src->release();
+
+                    //The reference held for the continuation
+                    self->release();
+                }
+
+            public:
+                inline ThenState( Functor &&fn, Executor &&e, FutureState<T> *s )
+                    : f( std::move( fn )), executor( std::move( e )), src( s ) {
+                    this->run = []( FutureNode *n ) {
+                        ThenState *self = static_cast<ThenState *>(n);
+
+                        self->executor.execute( &ThenState::invoke, self );
+                    };
+                }
+
+                //Takes over the reference to the source state, and hooks up to it
+                inline void start() {
+                    //One reference for the returned future, and one for the continuation until it has run
+                    this->add_ref();
+
+                    if( !this->src->attach( this )) {
+                        this->run( this );
+                    }
+                }
+        };
+    }
+}
+
+#endif //UV_FUTURE_DETAIL_HPP
@@ -30,7 +30,7 @@ namespace uv {
 
             Functor f;
 
-            inline Continuation( Functor _f ) noexcept : f( _f ) {}
+            inline Continuation( Functor _f ) noexcept : f( std::move( _f )) {}
 
             template <typename... Args>
             inline UV_DECLTYPE_AUTO dispatch( std::shared_ptr<Self> self, Args... args ) {
@@ -44,7 +44,7 @@ namespace uv {
 
             Functor f;
 
-            inline Continuation( Functor _f ) noexcept : f( _f ) {}
+            inline Continuation( Functor _f ) noexcept : f( std::move( _f )) {}
 
             template <typename... Args>
             inline UV_DECLTYPE_AUTO dispatch( std::shared_ptr<Self>, Args... args ) {
@@ -0,0 +1,382 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_LOCKFREE_DETAIL_HPP
+#define UV_LOCKFREE_DETAIL_HPP
+
+#include "../defines.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <cstdint>
+#include <memory>
+
+namespace uv {
+    namespace detail {
+        /*
+         * Intrusive multiple-producer single-consumer list.
+         *
+         * Any thread can push nodes onto it, but only one thread at a time should take them off. Nodes must have a
+         * `next` pointer member, which is owned by the list while the node is in it.
+         *
+         * Pushing returns true if the list was empty before, which is when the consumer needs to be woken up.
+         * Any push after the consumer has taken everything will see it empty again, so no wakeups are lost.
+         * */
+        template <typename T>
+        class MPSCList {
+            private:
+                std::atomic<T *> head;
+
+            public:
+                inline MPSCList() noexcept
+                    : head( nullptr ) {
+                }
+
+                MPSCList( const MPSCList & ) = delete;
+
+                inline bool push( T *t ) noexcept {
+                    return this->push( t, t );
+                }
+
+                //Pushes an already linked chain of nodes, with first->...->last
+                inline bool push( T *first, T *last ) noexcept {
+                    T *h = this->head.load( std::memory_order_relaxed );
+
+                    do {
+                        last->next = h;
+                    } while( !this->head.compare_exchange_weak( h, first, std::memory_order_release, std::memory_order_relaxed ));
+
+                    return h == nullptr;
+                }
+
+                //Takes everything, newest first
+                inline T *take_all_lifo() noexcept {
+                    return this->head.exchange( nullptr, std::memory_order_acquire );
+                }
+
+                //Takes everything, in the order it was pushed
+                inline T *take_all() noexcept {
+                    T *h    = this->take_all_lifo();
+                    T *prev = nullptr;
+
+                    while( h != nullptr ) {
+                        T *next = h->next;
+
+                        h->next = prev;
+                        prev    = h;
+                        h       = next;
+                    }
+
+                    return prev;
+                }
+
+                inline bool empty() const noexcept {
+                    return this->head.load( std::memory_order_relaxed ) == nullptr;
+                }
+        };
+
+        /*
+         * Lock-free pool of fixed slots, so hot paths can get storage without going to the allocator.
+         *
+         * Slots are allocated in segments that double in size and are never moved or freed until the pool itself is
+         * destroyed, so a slot index always refers to the same memory. That allows the free list head to be an index
+         * paired with a tag that changes on every operation, which avoids the ABA problem without needing a double
+         * width compare and exchange.
+         *
+         * Acquiring and releasing are safe from any thread. Only growing the pool takes a lock.
+         * */
+        template <typename T>
+        class SlotPool {
+            public:
+                struct Slot {
+                    T value;
+
+                    //Free for whoever holds the slot, like an MPSCList
+                    Slot *next = nullptr;
+
+                    uint32_t              index;
+                    std::atomic<uint32_t> next_free;
+                };
+
+                typedef T value_type;
+
+            private:
+                enum : uint32_t {
+                    NIL           = 0xFFFFFFFFu,
+                    FIRST_SEGMENT = 16,
+                    MAX_SEGMENTS  = 26
+                };
+
+                std::atomic<uint64_t> free_head;
+                std::atomic<Slot *>   segments[MAX_SEGMENTS];
+                std::atomic<uint32_t> num_segments;
+                std::mutex            grow_mutex;
+
+                inline static uint64_t tagged( uint64_t old_head, uint32_t index ) noexcept {
+                    return ((( old_head >> 32 ) + 1 ) << 32 ) | index;
+                }
+
+                inline static uint32_t segment_of( uint32_t index ) noexcept {
+                    uint32_t v = index / FIRST_SEGMENT + 1;
+#if defined(__GNUC__) || defined(__clang__)
+                    return 31 - (uint32_t)__builtin_clz( v );
+#else
+                    uint32_t k = 0;
+
+                    while( v >>= 1 ) {
+                        ++k;
+                    }
+
+                    return k;
+#endif
+                }
+
+                inline Slot *at( uint32_t index ) const noexcept {
+                    uint32_t k = segment_of( index );
+
+                    return this->segments[k].load( std::memory_order_acquire ) + ( index - FIRST_SEGMENT * (( 1u << k ) - 1 ));
+                }
+
+                //Adds another segment onto the free list, with grow_mutex held
+                void add_segment() {
+                    uint32_t k = this->num_segments.load( std::memory_order_relaxed );
+
+                    if( k == MAX_SEGMENTS ) {
+                        throw std::bad_alloc();
+                    }
+
+                    uint32_t size  = FIRST_SEGMENT << k;
+                    uint32_t first = FIRST_SEGMENT * (( 1u << k ) - 1 );
+
+                    Slot *seg = new Slot[size];
+
+                    for( uint32_t i = 0; i < size; ++i ) {
+                        seg[i].index = first + i;
+                        seg[i].next_free.store( first + i + 1, std::memory_order_relaxed );
+                    }
+
+                    this->segments[k].store( seg, std::memory_order_release );
+                    this->num_segments.store( k + 1, std::memory_order_release );
+
+                    //Splice the whole segment onto the free list at once
+                    Slot     *last = seg + size - 1;
+                    uint64_t head  = this->free_head.load( std::memory_order_relaxed );
+
+                    do {
+                        last->next_free.store((uint32_t)head, std::memory_order_relaxed );
+                    } while( !this->free_head.compare_exchange_weak( head, tagged( head, first ), std::memory_order_release, std::memory_order_relaxed ));
+                }
+
+                void grow() {
+                    std::lock_guard<std::mutex> lock( this->grow_mutex );
+
+                    //Someone else may have grown it or released slots while waiting on the lock
+                    if((uint32_t)this->free_head.load( std::memory_order_acquire ) == NIL ) {
+                        this->add_segment();
+                    }
+                }
+
+            public:
+                inline SlotPool() noexcept
+                    : free_head( NIL ), num_segments( 0 ) {
+                    for( auto &s : this->segments ) {
+                        s.store( nullptr, std::memory_order_relaxed );
+                    }
+                }
+
+                SlotPool( const SlotPool & ) = delete;
+
+                Slot *acquire() {
+                    uint64_t head = this->free_head.load( std::memory_order_acquire );
+
+                    for( ;; ) {
+                        uint32_t index = (uint32_t)head;
+
+                        if( index == NIL ) {
+                            this->grow();
+
+                            head = this->free_head.load( std::memory_order_acquire );
+
+                        } else {
+                            Slot *s = this->at( index );
+
+                            //This may be stale if another thread got here first, but then the tag won't match
+                            uint32_t next = s->next_free.load( std::memory_order_relaxed );
+
+                            if( this->free_head.compare_exchange_weak( head, tagged( head, next ), std::memory_order_acquire, std::memory_order_acquire )) {
+                                return s;
+                            }
+                        }
+                    }
+                }
+
+                inline void release( Slot *s ) noexcept {
+                    uint64_t head = this->free_head.load( std::memory_order_relaxed );
+
+                    do {
+                        s->next_free.store((uint32_t)head, std::memory_order_relaxed );
+                    } while( !this->free_head.compare_exchange_weak( head, tagged( head, s->index ), std::memory_order_release, std::memory_order_relaxed ));
+                }
+
+                //Grows the pool until it has at least n slots in total
+                void reserve( size_t n ) {
+                    std::lock_guard<std::mutex> lock( this->grow_mutex );
+
+                    while( this->capacity() < n ) {
+                        this->add_segment();
+                    }
+                }
+
+                inline size_t capacity() const noexcept {
+                    uint32_t k = this->num_segments.load( std::memory_order_acquire );
+
+                    return FIRST_SEGMENT * (( size_t( 1 ) << k ) - 1 );
+                }
+
+                ~SlotPool() {
+                    for( auto &s : this->segments ) {
+                        delete[] s.load( std::memory_order_relaxed );
+                    }
+                }
+        };
+
+        /*
+         * Chase-Lev work-stealing deque, with the memory orderings from "Correct and Efficient Work-Stealing for Weak
+         * Memory Models" by Lê et al.
+         *
+         * The owning thread pushes and pops at the bottom, while any other thread can steal from the top. The buffer
+         * doubles when it fills up, and old buffers are only freed with the deque, since a thief may still be reading
+         * from one.
+         * */
+        template <typename T>
+        class WorkStealingDeque {
+            private:
+                struct Buffer {
+                    size_t                              mask;
+                    std::unique_ptr<std::atomic<T *>[]> slots;
+                    std::unique_ptr<Buffer>             previous;
+
+                    inline explicit Buffer( size_t capacity )
+                        : mask( capacity - 1 ), slots( new std::atomic<T *>[capacity] ) {
+                    }
+
+                    inline T *get( int64_t i ) const noexcept {
+                        return this->slots[(size_t)i & this->mask].load( std::memory_order_relaxed );
+                    }
+
+                    inline void put( int64_t i, T *t ) noexcept {
+                        this->slots[(size_t)i & this->mask].store( t, std::memory_order_relaxed );
+                    }
+                };
+
+                std::atomic<int64_t>  top;
+                std::atomic<int64_t>  bottom;
+                std::atomic<Buffer *> buffer;
+
+                Buffer *grow( Buffer *old, int64_t t, int64_t b ) {
+                    Buffer *bigger = new Buffer(( old->mask + 1 ) * 2 );
+
+                    for( int64_t i = t; i < b; ++i ) {
+                        bigger->put( i, old->get( i ));
+                    }
+
+                    bigger->previous.reset( old );
+
+                    this->buffer.store( bigger, std::memory_order_release );
+
+                    return bigger;
+                }
+
+            public:
+                //The capacity must be a power of two
+                inline explicit WorkStealingDeque( size_t capacity = 256 )
+                    : top( 0 ), bottom( 0 ), buffer( new Buffer( capacity )) {
+                    assert(( capacity & ( capacity - 1 )) == 0 );
+                }
+
+                WorkStealingDeque( const WorkStealingDeque & ) = delete;
+
+                //Owner only
+                void push( T *t ) {
+                    int64_t b = this->bottom.load( std::memory_order_relaxed );
+                    int64_t f = this->top.load( std::memory_order_acquire );
+
+                    Buffer *a = this->buffer.load( std::memory_order_relaxed );
+
+                    if( b - f > (int64_t)a->mask ) {
+                        a = this->grow( a, f, b );
+                    }
+
+                    a->put( b, t );
+
+                    this->bottom.store( b + 1, std::memory_order_release );
+                }
+
+                //Owner only, newest first
+                T *pop() noexcept {
+                    int64_t b = this->bottom.load( std::memory_order_relaxed ) - 1;
+
+                    Buffer *a = this->buffer.load( std::memory_order_relaxed );
+
+                    this->bottom.store( b, std::memory_order_relaxed );
+
+                    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                    int64_t f = this->top.load( std::memory_order_relaxed );
+
+                    if( f > b ) {
+                        this->bottom.store( b + 1, std::memory_order_relaxed );
+
+                        return nullptr;
+                    }
+
+                    T *t = a->get( b );
+
+                    //The last one left, which a thief may be after as well
+                    if( f == b ) {
+                        if( !this->top.compare_exchange_strong( f, f + 1, std::memory_order_seq_cst, std::memory_order_relaxed )) {
+                            t = nullptr;
+                        }
+
+                        this->bottom.store( b + 1, std::memory_order_relaxed );
+                    }
+
+                    return t;
+                }
+
+                //Any thread, oldest first. Returns nullptr if it's empty or another thread won the race.
+                T *steal() noexcept {
+                    int64_t f = this->top.load( std::memory_order_acquire );
+
+                    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                    int64_t b = this->bottom.load( std::memory_order_acquire );
+
+                    if( f >= b ) {
+                        return nullptr;
+                    }
+
+                    T *t = this->buffer.load( std::memory_order_acquire )->get( f );
+
+                    if( !this->top.compare_exchange_strong( f, f + 1, std::memory_order_seq_cst, std::memory_order_relaxed )) {
+                        return nullptr;
+                    }
+
+                    return t;
+                }
+
+                //Only a hint from anything but the owner
+                inline bool empty() const noexcept {
+                    return this->bottom.load( std::memory_order_relaxed ) <= this->top.load( std::memory_order_relaxed );
+                }
+
+                ~WorkStealingDeque() {
+                    delete this->buffer.load( std::memory_order_relaxed );
+                }
+        };
+    }
+}
+
+#endif //UV_LOCKFREE_DETAIL_HPP
@@ -0,0 +1,69 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_SPAN_DETAIL_HPP
+#define UV_SPAN_DETAIL_HPP
+
+#include <cstddef>
+#include <cassert>
+
+namespace uv {
+    namespace detail {
+        /*
+         * Non-owning view of a contiguous run of values, for handing batches to callbacks without copying them.
+         *
+         * The values are only valid for the duration of the callback, but they can be moved out of.
+         * */
+        template <typename T>
+        class Span {
+            private:
+                T           *_data;
+                std::size_t _size;
+
+            public:
+                typedef T           value_type;
+                typedef T           *iterator;
+                typedef const T     *const_iterator;
+                typedef std::size_t size_type;
+
+                constexpr Span() noexcept
+                    : _data( nullptr ), _size( 0 ) {
+                }
+
+                constexpr Span( T *d, std::size_t n ) noexcept
+                    : _data( d ), _size( n ) {
+                }
+
+                inline T *data() const noexcept {
+                    return this->_data;
+                }
+
+                inline std::size_t size() const noexcept {
+                    return this->_size;
+                }
+
+                inline bool empty() const noexcept {
+                    return this->_size == 0;
+                }
+
+                inline T &operator[]( std::size_t i ) const noexcept {
+                    assert( i < this->_size );
+
+                    return this->_data[i];
+                }
+
+                inline T *begin() const noexcept {
+                    return this->_data;
+                }
+
+                inline T *end() const noexcept {
+                    return this->_data + this->_size;
+                }
+        };
+    }
+
+    using detail::Span;
+}
+
+#endif //UV_SPAN_DETAIL_HPP
@@ -8,6 +8,8 @@
 #include "../defines.hpp"
 #include "function_traits.hpp"
 
+#include "../future.hpp"
+
 #include <future>
 
 /*
@@ -20,6 +22,10 @@
  * It will also resolve futures/promises returned by the callback, so the future returned by `then` will always resolve to a non-future type.
  *
  * Basically, you can layer up whatever you want and it'll resolve them all.
+ *
+ * The std::async based overloads can start a thread per continuation, or do nothing at all until someone calls get().
+ * The overloads that take a Loop or an executor never block or create threads. They register the continuation with the
+ * source and return a uv::Future, which is thenable itself.
  * */
 
 namespace uv {
@@ -33,8 +39,9 @@ namespace uv {
         constexpr launch default_policy = launch::deferred | launch::async;
 
         /*
-         * This is a special launch type where it is guarenteed to spawn a new thread to run the task
-         * asynchronously. It will not wait on any calls to .get() on the resulting future.
+         * This used to be a special launch type that spawned a new thread to run the task. It no longer does: the
+         * callback runs on the default loop instead, which has to be running, and must not be blocked waiting on the
+         * result. Those overloads are deprecated, so pass the loop or executor to run on explicitly.
          *
          * 3 was chosen because deferred and async are usually 1 and 2, though it doesn't matter since this
          * is a type-safe enum class anyway.
@@ -69,24 +76,54 @@ namespace uv {
          *
          * There are no default overloads because these will ONLY be called if the uv_launch::detached
          * flag is given, ensuring these overloads are called instead of the above.
+         *
+         * Deprecated, since they quietly run the callback on the default loop. Pass a loop or executor instead.
          * */
 
-        //TODO: Implement these
-
         template <typename T, typename Functor>
+        [[deprecated( "pass a loop or executor to then instead" )]]
         UV_DECLTYPE_AUTO then( future<T> &, Functor, uv_launch );
 
         template <typename T, typename Functor>
+        [[deprecated( "pass a loop or executor to then instead" )]]
         UV_DECLTYPE_AUTO then( shared_future<T>, Functor, uv_launch );
 
         template <typename T, typename Functor>
+        [[deprecated( "pass a loop or executor to then instead" )]]
         UV_DECLTYPE_AUTO then( future<T> &&, Functor, uv_launch );
 
         template <typename T, typename Functor>
+        [[deprecated( "pass a loop or executor to then instead" )]]
         UV_DECLTYPE_AUTO then( promise<T> &, Functor, uv_launch );
 
         //////////
 
+        /*
+         * Forward declarations for loop and executor overloads, which never block or create threads.
+         *
+         * The loop is a template parameter only so Loop doesn't have to be complete here.
+         * */
+
+        template <typename T, typename L, typename Functor>
+        UV_DECLTYPE_AUTO then( future<T> &&, shared_ptr<L>, Functor );
+
+        template <typename T, typename L, typename Functor>
+        UV_DECLTYPE_AUTO then( future<T> &, shared_ptr<L>, Functor );
+
+        template <typename T, typename L, typename Functor>
+        UV_DECLTYPE_AUTO then( shared_future<T>, shared_ptr<L>, Functor );
+
+        template <typename T, typename L, typename Functor>
+        UV_DECLTYPE_AUTO then( promise<T> &, shared_ptr<L>, Functor );
+
+        template <typename T, typename Executor, typename Functor>
+        UV_DECLTYPE_AUTO then( ::uv::Future<T> &&, Executor, Functor );
+
+        template <typename T, typename Functor>
+        UV_DECLTYPE_AUTO then( ::uv::Future<T> &&, Functor );
+
+        //////////
+
         template <typename... Args>
         UV_DECLTYPE_AUTO then2( Args... );
 
@@ -322,6 +359,78 @@ namespace uv {
 
         //////////
 
+        /*
+         * then function, loop and executor overloads
+         *
+         * A std::future has no way of notifying anything, so it's handed to the loop, which polls it from a single
+         * timer with backoff. The continuation then runs on the loop thread as soon as the poll finds it ready.
+         *
+         * uv::Future notifies whoever completes it, so its continuations go straight to the executor.
+         * */
+
+        template <typename T, typename L, typename Functor>
+        inline UV_DECLTYPE_AUTO then( future<T> &&s, shared_ptr<L> l, Functor f ) {
+            //Completed on the loop thread already, so the continuation can run inline
+            return l->poll_future( move( s )).then( move( f ));
+        };
+
+        template <typename T, typename L, typename Functor>
+        inline UV_DECLTYPE_AUTO then( future<T> &s, shared_ptr<L> l, Functor f ) {
+            return then( move( s ), move( l ), move( f ));
+        };
+
+        template <typename T, typename L, typename Functor>
+        inline UV_DECLTYPE_AUTO then( shared_future<T> s, shared_ptr<L> l, Functor f ) {
+            return l->poll_future( move( s )).then( move( f ));
+        };
+
+        template <typename T, typename L, typename Functor>
+        inline UV_DECLTYPE_AUTO then( promise<T> &s, shared_ptr<L> l, Functor f ) {
+            return then( s.get_future(), move( l ), move( f ));
+        };
+
+        template <typename T, typename Executor, typename Functor>
+        inline UV_DECLTYPE_AUTO then( ::uv::Future<T> &&s, Executor e, Functor f ) {
+            return s.then( move( e ), move( f ));
+        };
+
+        template <typename T, typename Functor>
+        inline UV_DECLTYPE_AUTO then( ::uv::Future<T> &&s, Functor f ) {
+            return s.then( move( f ));
+        };
+
+        //////////
+
+        /*
+         * then function, detached overloads
+         *
+         * These return right away without waiting on anything, and run the callback on the default loop once the
+         * future is ready. The default loop has to be running for that to happen, so anything blocking it on the
+         * result never finishes. Deprecated in favor of the loop and executor overloads above.
+         * */
+
+        template <typename T, typename Functor>
+        inline UV_DECLTYPE_AUTO then( future<T> &&s, Functor f, uv_launch ) {
+            return then( move( s ), ::uv::default_loop(), move( f ));
+        };
+
+        template <typename T, typename Functor>
+        inline UV_DECLTYPE_AUTO then( future<T> &s, Functor f, uv_launch ) {
+            return then( move( s ), ::uv::default_loop(), move( f ));
+        };
+
+        template <typename T, typename Functor>
+        inline UV_DECLTYPE_AUTO then( shared_future<T> s, Functor f, uv_launch ) {
+            return then( move( s ), ::uv::default_loop(), move( f ));
+        };
+
+        template <typename T, typename Functor>
+        inline UV_DECLTYPE_AUTO then( promise<T> &s, Functor f, uv_launch ) {
+            return then( s.get_future(), ::uv::default_loop(), move( f ));
+        };
+
+        //////////
+
         /*
          * Just a little trick to get the type of a future when it's not known beforehand.
          *
@@ -378,14 +487,25 @@ namespace uv {
 
         //////////
 
+        /*
+         * Wraps std::futures in a ThenableFuture. uv::Future can be chained already, so it's passed through.
+         * */
+        template <typename T>
+        inline ThenableFuture<T> make_thenable( future<T> &&f ) {
+            return ThenableFuture<T>( move( f ));
+        }
+
+        template <typename T>
+        inline ::uv::Future<T> make_thenable( ::uv::Future<T> &&f ) {
+            return move( f );
+        }
+
         /*
          * then2 is a variation of then that returns a ThenableFuture instead of a normal future
          * */
         template <typename... Args>
         inline UV_DECLTYPE_AUTO then2( Args... args ) {
-            auto &&k = then( std::forward<Args>( args )... );
-
-            return ThenableFuture<typename get_future_type<typename remove_reference<decltype( k )>::type>::type>( move( k ));
+            return make_thenable( then( std::forward<Args>( args )... ));
         }
     }
 
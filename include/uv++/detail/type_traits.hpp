@@ -6,6 +6,7 @@
 #define UV_TYPE_TRAITS_DETAIL_HPP
 
 #include <type_traits>
+#include <tuple>
 
 namespace uv {
     namespace detail {
@@ -20,6 +21,26 @@ namespace uv {
         struct all_type<K, T, Rest...>
             : std::integral_constant<bool, std::is_convertible<T, K>::value && all_type<K, Rest...>::value> {
         };
+
+        /*
+         * Storage type for a tuple of parameters, so asynchronous calls hold on to values instead of references
+         * to arguments that are long gone by the time they're used.
+         * */
+        template <typename T>
+        struct decay_tuple;
+
+        template <typename... Args>
+        struct decay_tuple<std::tuple<Args...>> {
+            typedef std::tuple<typename std::decay<Args>::type...> type;
+        };
+
+        /*
+         * How a stored value should be handed to a parameter of type P. Lvalue references get an lvalue,
+         * and everything else gets an rvalue so move-only types can be passed along.
+         * */
+        template <typename P>
+        using forward_as_t = typename std::conditional<std::is_lvalue_reference<P>::value, P,
+                                                       typename std::remove_reference<P>::type &&>::type;
     }
 }
 
@@ -5,6 +5,8 @@
 #ifndef UV_UTILS_DETAIL_HPP
 #define UV_UTILS_DETAIL_HPP
 
+#include "type_traits.hpp"
+
 #include <tuple>
 #include <future>
 
@@ -63,6 +65,24 @@ namespace uv {
                                   std::make_index_sequence<Size>{} );
         }
 
+        template <typename Params, typename Functor, typename T, std::size_t... S>
+        inline UV_DECLTYPE_AUTO invoke_stored_helper( Functor &&func, T &t, std::index_sequence<S...> ) {
+            return func( static_cast<forward_as_t<typename std::tuple_element<S, Params>::type>>( std::get<S>( t ))... );
+        }
+
+        /*
+         * Like invoke, but for a tuple of stored arguments that is used up by the call. Each value is moved into
+         * its parameter unless the parameter (given by the Params tuple) is an lvalue reference.
+         * */
+        template <typename Params, typename Functor, typename T>
+        inline UV_DECLTYPE_AUTO invoke_stored( Functor &&func, T &t ) {
+            constexpr auto Size = std::tuple_size<typename std::decay<T>::type>::value;
+
+            return invoke_stored_helper<Params>( std::forward<Functor>( func ),
+                                                 t,
+                                                 std::make_index_sequence<Size>{} );
+        }
+
         template <typename T>
         inline std::future<T> make_ready_future( T &&t ) noexcept {
             std::promise<T> p;
@@ -133,7 +153,7 @@ namespace uv {
 
         template <class T>
         inline const T &clamp( const T &v, const T &lo, const T &hi ) noexcept {
-            return clamp( v, lo, hi, std::less<>());
+            return detail::clamp( v, lo, hi, std::less<>());
         }
 
         namespace _then {
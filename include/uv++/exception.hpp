@@ -7,20 +7,97 @@
 
 #include "defines.hpp"
 
+#include <system_error>
+
 namespace uv {
+    namespace detail {
+        class ErrorCategory final : public std::error_category {
+            public:
+                inline const char *name() const noexcept override {
+                    return "uv";
+                }
+
+                inline std::string message( int e ) const override {
+                    return uv_strerror( e );
+                }
+
+                /*
+                 * On Unix, most libuv errors are just negated errno values, so they compare equal to the matching std::errc.
+                 * The getaddrinfo errors, UV_EOF and the few libuv makes up itself start at -3000 and stay as they are.
+                 * */
+                inline std::error_condition default_error_condition( int e ) const noexcept override {
+#ifndef _WIN32
+                    if( e < 0 && e > UV_EAI_ADDRFAMILY ) {
+                        return std::error_condition( -e, std::generic_category());
+                    }
+#endif
+                    return std::error_condition( e, *this );
+                }
+        };
+    }
+
+    //Category for libuv's negative error codes, like UV_EAGAIN
+    inline const std::error_category &error_category() noexcept {
+        static detail::ErrorCategory category;
+
+        return category;
+    }
+
+    inline std::error_code make_error_code( int e ) noexcept {
+        return std::error_code( e, error_category());
+    }
+
     class Exception : public std::exception {
         private:
             const char *__what;
+            int        __code;
 
         public:
-            inline Exception( const char *w ) noexcept : __what( w ) {}
+            inline Exception( const char *w ) noexcept : __what( w ), __code( 0 ) {}
 
-            inline Exception( int e ) noexcept : Exception( uv_strerror( e )) {}
+            inline Exception( int e ) noexcept : __what( uv_strerror( e )), __code( e ) {}
 
             inline const char *what() const noexcept {
                 return this->__what;
             }
+
+            //Zero if it was only given a message
+            inline std::error_code code() const noexcept {
+                return make_error_code( this->__code );
+            }
     };
+
+    namespace detail {
+        //Errors from the uv category become ::uv::Exception, anything else std::system_error
+        inline std::exception_ptr make_error_exception( const std::error_code &ec ) {
+            if( ec.category() == error_category()) {
+                return std::make_exception_ptr( ::uv::Exception( ec.value()));
+            }
+
+            return std::make_exception_ptr( std::system_error( ec ));
+        }
+
+        [[noreturn]] inline void throw_error( const std::error_code &ec ) {
+            if( ec.category() == error_category()) {
+                throw ::uv::Exception( ec.value());
+            }
+
+            throw std::system_error( ec );
+        }
+
+        //Sets the error code from a libuv result, and returns whether it was a success
+        inline bool set_error( std::error_code &ec, int res ) noexcept {
+            if( res < 0 ) {
+                ec = make_error_code( res );
+
+                return false;
+            }
+
+            ec.clear();
+
+            return true;
+        }
+    }
 }
 
 #endif //UV_EXCEPTION_HPP
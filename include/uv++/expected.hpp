@@ -0,0 +1,225 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_EXPECTED_HPP
+#define UV_EXPECTED_HPP
+
+#include "exception.hpp"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace uv {
+    //Wraps an error for constructing an expected, so it can't be mistaken for a value
+    struct unexpected {
+        std::error_code error;
+
+        inline explicit unexpected( std::error_code ec ) noexcept
+            : error( ec ) {
+        }
+
+        inline explicit unexpected( int e ) noexcept
+            : error( make_error_code( e )) {
+        }
+    };
+
+    /*
+     * Either a value or an error code, for the non-throwing parts of the library where errors like UV_EAGAIN are
+     * routine and shouldn't cost an exception.
+     *
+     * value() throws the error if there isn't a value, as a ::uv::Exception for libuv errors, so code that doesn't
+     * care can still treat it like the throwing API.
+     * */
+    template <typename T>
+    class expected {
+        protected:
+            typename std::aligned_storage<sizeof( T ), alignof( T )>::type storage;
+
+            std::error_code ec;
+
+            bool has = false;
+
+            inline T *ptr() noexcept {
+                return reinterpret_cast<T *>(&this->storage);
+            }
+
+            inline const T *ptr() const noexcept {
+                return reinterpret_cast<const T *>(&this->storage);
+            }
+
+            inline void reset() noexcept {
+                if( this->has ) {
+                    this->ptr()->~T();
+
+                    this->has = false;
+                }
+            }
+
+        public:
+            typedef T value_type;
+
+            inline expected( const T &t )
+                : has( true ) {
+                new( &this->storage ) T( t );
+            }
+
+            inline expected( T &&t )
+                : has( true ) {
+                new( &this->storage ) T( std::move( t ));
+            }
+
+            inline expected( unexpected u ) noexcept
+                : ec( u.error ) {
+            }
+
+            inline expected( const expected &other )
+                : ec( other.ec ), has( other.has ) {
+                if( this->has ) {
+                    new( &this->storage ) T( *other.ptr());
+                }
+            }
+
+            inline expected( expected &&other ) noexcept( std::is_nothrow_move_constructible<T>::value )
+                : ec( other.ec ), has( other.has ) {
+                if( this->has ) {
+                    new( &this->storage ) T( std::move( *other.ptr()));
+                }
+            }
+
+            inline expected &operator=( const expected &other ) {
+                if( this != &other ) {
+                    this->reset();
+
+                    this->ec = other.ec;
+
+                    if( other.has ) {
+                        new( &this->storage ) T( *other.ptr());
+
+                        this->has = true;
+                    }
+                }
+
+                return *this;
+            }
+
+            inline expected &operator=( expected &&other ) noexcept( std::is_nothrow_move_constructible<T>::value ) {
+                if( this != &other ) {
+                    this->reset();
+
+                    this->ec = other.ec;
+
+                    if( other.has ) {
+                        new( &this->storage ) T( std::move( *other.ptr()));
+
+                        this->has = true;
+                    }
+                }
+
+                return *this;
+            }
+
+            inline bool has_value() const noexcept {
+                return this->has;
+            }
+
+            inline explicit operator bool() const noexcept {
+                return this->has;
+            }
+
+            inline const std::error_code &error() const noexcept {
+                return this->ec;
+            }
+
+            inline T &value() & {
+                if( !this->has ) {
+                    detail::throw_error( this->ec );
+                }
+
+                return *this->ptr();
+            }
+
+            inline const T &value() const & {
+                if( !this->has ) {
+                    detail::throw_error( this->ec );
+                }
+
+                return *this->ptr();
+            }
+
+            inline T &&value() && {
+                if( !this->has ) {
+                    detail::throw_error( this->ec );
+                }
+
+                return std::move( *this->ptr());
+            }
+
+            template <typename U>
+            inline T value_or( U &&u ) const & {
+                return this->has ? *this->ptr() : static_cast<T>( std::forward<U>( u ));
+            }
+
+            template <typename U>
+            inline T value_or( U &&u ) && {
+                return this->has ? std::move( *this->ptr()) : static_cast<T>( std::forward<U>( u ));
+            }
+
+            //Unchecked
+            inline T &operator*() noexcept {
+                return *this->ptr();
+            }
+
+            inline const T &operator*() const noexcept {
+                return *this->ptr();
+            }
+
+            inline T *operator->() noexcept {
+                return this->ptr();
+            }
+
+            inline const T *operator->() const noexcept {
+                return this->ptr();
+            }
+
+            ~expected() {
+                this->reset();
+            }
+    };
+
+    template <>
+    class expected<void> {
+        protected:
+            std::error_code ec;
+
+        public:
+            typedef void value_type;
+
+            inline expected() noexcept = default;
+
+            inline expected( unexpected u ) noexcept
+                : ec( u.error ) {
+            }
+
+            inline bool has_value() const noexcept {
+                return !this->ec;
+            }
+
+            inline explicit operator bool() const noexcept {
+                return !this->ec;
+            }
+
+            inline const std::error_code &error() const noexcept {
+                return this->ec;
+            }
+
+            inline void value() const {
+                if( this->ec ) {
+                    detail::throw_error( this->ec );
+                }
+            }
+    };
+}
+
+#endif //UV_EXPECTED_HPP
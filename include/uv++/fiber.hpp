@@ -0,0 +1,263 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_FIBER_HPP
+#define UV_FIBER_HPP
+
+#include "loop.hpp"
+
+#ifdef __linux__
+
+#include <thread>
+
+/*
+ * Blocking-style code on a loop, for code that can't be turned into callbacks or coroutines.
+ *
+ * Start a fiber with loop->fiber( f ), and inside it these look and act like blocking calls, but only suspend the fiber
+ * while the loop carries on with everything else. The fiber is resumed right from the libuv callback, or through the
+ * loop's task queue when something completes on another thread.
+ *
+ * Outside of a fiber, they fall back to actually blocking, so the same code works either way.
+ * */
+
+namespace uv {
+    namespace detail {
+        struct FiberWaitNode : FutureNode {
+            Fiber *fiber;
+        };
+
+        template <typename R>
+        struct fiber_invoke {
+            template <typename Functor>
+            static inline void apply( Outcome<R> &o, Functor &f ) {
+                o.set_value( f());
+            }
+        };
+
+        template <>
+        struct fiber_invoke<void> {
+            template <typename Functor>
+            static inline void apply( Outcome<void> &o, Functor &f ) {
+                f();
+
+                o.set_value();
+            }
+        };
+
+        //Runs a uv_fs_* function and suspends the fiber until its callback, or runs it synchronously outside of one
+        template <typename Transform, typename Functor, typename... Args>
+        auto fiber_fs_request( Transform t, Functor uf, Args &&... args ) -> decltype( t( std::declval<uv_fs_t *>())) {
+            Fiber *self = FiberHost::current();
+
+            uv_fs_t req;
+
+            ssize_t res;
+
+            if( self == nullptr ) {
+                res = uf( uv_default_loop(), &req, fs_arg( args )..., nullptr );
+
+            } else {
+                req.data = self;
+
+                res = uf( loop_handle( self->host->owner()), &req, fs_arg( args )..., []( uv_fs_t *r ) {
+                    Fiber *fb = static_cast<Fiber *>(r->data);
+
+                    fb->host->resume( fb );
+                } );
+
+                if( res >= 0 ) {
+                    FiberHost::suspend();
+
+                    res = req.result;
+                }
+            }
+
+            struct cleanup {
+                uv_fs_t *req;
+
+                ~cleanup() {
+                    uv_fs_req_cleanup( req );
+                }
+            } c{ &req };
+
+            if( res < 0 ) {
+                throw ::uv::Exception((int)res );
+            }
+
+            return t( &req );
+        }
+    }
+
+    inline bool in_fiber() noexcept {
+        return detail::FiberHost::current() != nullptr;
+    }
+
+    /*
+     * Suspends the fiber until the future is ready, then returns its value or throws its exception.
+     * */
+    template <typename T>
+    T fiber_await( Future<T> f ) {
+        detail::Fiber *self = detail::FiberHost::current();
+
+        if( self != nullptr ) {
+            detail::FiberWaitNode n;
+
+            n.fiber = self;
+            n.run   = []( detail::FutureNode *fn ) {
+                detail::Fiber *fb = static_cast<detail::FiberWaitNode *>(fn)->fiber;
+
+                fb->host->post_resume( fb );
+            };
+
+            if( detail::future_access::state( f )->attach( &n )) {
+                detail::FiberHost::suspend();
+            }
+        }
+
+        return f.get();
+    }
+
+    //std::futures, like the ones from Work::queue and Filesystem, are polled by the loop while the fiber waits
+    template <typename T>
+    T fiber_await( std::future<T> f ) {
+        if( detail::Fiber *self = detail::FiberHost::current()) {
+            return fiber_await( self->host->owner()->poll_future( std::move( f )));
+        }
+
+        return f.get();
+    }
+
+    template <typename T>
+    T fiber_await( std::shared_future<T> f ) {
+        if( detail::Fiber *self = detail::FiberHost::current()) {
+            return fiber_await( self->host->owner()->poll_future( std::move( f )));
+        }
+
+        return f.get();
+    }
+
+    //Lets everything else waiting on the loop run before carrying on
+    inline void fiber_yield() {
+        if( detail::Fiber *self = detail::FiberHost::current()) {
+            self->host->post_resume( self );
+
+            detail::FiberHost::suspend();
+
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    template <typename _Rep, typename _Period>
+    void fiber_sleep( const std::chrono::duration<_Rep, _Period> &timeout ) {
+        typedef std::chrono::duration<uint64_t, std::milli> millis;
+
+        detail::Fiber *self = detail::FiberHost::current();
+
+        if( self == nullptr ) {
+            std::this_thread::sleep_for( timeout );
+
+            return;
+        }
+
+        //The timer lives on the fiber's stack, so it has to be closed before the fiber carries on
+        uv_timer_t timer;
+
+        uv_timer_init( detail::loop_handle( self->host->owner()), &timer );
+
+        timer.data = self;
+
+        uv_timer_start( &timer, []( uv_timer_t *t ) {
+            uv_close((uv_handle_t *)t, []( uv_handle_t *h ) {
+                detail::Fiber *fb = static_cast<detail::Fiber *>(h->data);
+
+                fb->host->resume( fb );
+            } );
+        }, std::chrono::duration_cast<millis>( timeout ).count(), 0 );
+
+        detail::FiberHost::suspend();
+    }
+
+    /*
+     * Runs the functor on the thread-pool, with the fiber resumed from the after-work callback. Outside of a fiber,
+     * the functor just runs on the calling thread. Like Loop::queue_work, it isn't given a Work priority.
+     * */
+    template <typename Functor, typename... Args>
+    auto fiber_work( Functor &&f, Args &&... args ) -> decltype( std::declval<Functor &>()( std::declval<Args &>()... )) {
+        typedef decltype( std::declval<Functor &>()( std::declval<Args &>()... )) R;
+
+        auto call = [&f, &args...]() -> R {
+            return f( args... );
+        };
+
+        detail::Fiber *self = detail::FiberHost::current();
+
+        if( self == nullptr ) {
+            return call();
+        }
+
+        //Everything stays on the fiber's stack while it's suspended
+        struct Op {
+            uv_work_t          req;
+            decltype( call )   *fn;
+            detail::Outcome<R> outcome;
+            detail::Fiber      *fiber;
+            int                status;
+        } op;
+
+        op.req.data = &op;
+        op.fn       = &call;
+        op.fiber    = self;
+        op.status   = 0;
+
+        int res = uv_queue_work( detail::loop_handle( self->host->owner()), &op.req, []( uv_work_t *w ) {
+            Op *o = static_cast<Op *>(w->data);
+
+            try {
+                detail::fiber_invoke<R>::apply( o->outcome, *o->fn );
+
+            } catch( ... ) {
+                o->outcome.set_exception( std::current_exception());
+            }
+
+        }, []( uv_work_t *w, int status ) {
+            Op *o = static_cast<Op *>(w->data);
+
+            o->status = status;
+
+            o->fiber->host->resume( o->fiber );
+        } );
+
+        if( res < 0 ) {
+            throw ::uv::Exception( res );
+        }
+
+        detail::FiberHost::suspend();
+
+        if( op.status != 0 ) {
+            throw ::uv::Exception( op.status );
+        }
+
+        return op.outcome.take();
+    }
+
+    /*
+     * Works with any uv_fs_* function, like fiber_fs( uv_fs_open, path, flags, mode ), returning the result of the
+     * request or throwing if it's negative.
+     * */
+    template <typename Functor, typename... Args>
+    inline ssize_t fiber_fs( Functor uf, Args &&... args ) {
+        return detail::fiber_fs_request( []( uv_fs_t *req ) {
+            return req->result;
+        }, uf, std::forward<Args>( args )... );
+    }
+
+    inline fs::Stat fiber_stat( const std::string &path ) {
+        return detail::fiber_fs_request( fs::Filesystem::StatTransform{}, uv_fs_stat, path );
+    }
+}
+
+#endif //__linux__
+
+#endif //UV_FIBER_HPP
@@ -7,15 +7,16 @@
 
 #include "requests/fs.hpp"
 #include "detail/fs.hpp"
+#include "detail/coro.hpp"
 
 namespace uv {
     namespace fs {
         template <typename T>
         class FSResult : public std::future<T> {
             protected:
-                std::unique_ptr<FSRequest> _request;
+                std::shared_ptr<FSRequest> _request;
 
-                inline FSResult( std::future<T> &&f, std::unique_ptr<FSRequest> &&r ) noexcept
+                inline FSResult( std::future<T> &&f, std::shared_ptr<FSRequest> &&r ) noexcept
                     : std::future<T>( std::move( f )), _request( std::move( r )) {
                 }
 
@@ -63,22 +64,51 @@ namespace uv {
                     this->init( l );
                 }
 
-                FSResult<Stat> stat( const std::string &path ) {
-                    auto request = std::make_unique<FSRequest>();
+                //The request is cancelled if the token is cancelled before it's picked up by the thread-pool
+                FSResult<Stat> stat( const std::string &path, const CancellationToken &token = CancellationToken()) {
+                    //Requests hand out weak references to themselves, so they have to be owned by a shared_ptr
+                    auto request = std::make_shared<FSRequest>();
 
                     request->init( this->loop());
 
-                    auto result = util::then( request->promisify( uv_fs_stat, path.c_str()), []( uv_fs_t *req ) {
+                    //The Stat is built and the promise satisfied right in the fs callback, on the loop thread
+                    auto result = request->fulfil<Stat>( token, []( uv_fs_t *req ) {
                         Stat a( req->statbuf );
 
                         uv_fs_req_cleanup( req );
 
                         return a;
-                    } );
+                    }, uv_fs_stat, path );
 
                     //FSResult takes ownership of request
                     return FSResult<Stat>( std::move( result ), std::move( request ));
                 }
+
+                //Builds the Stat from a finished request, for coroutines and fibers
+                struct StatTransform {
+                    inline Stat operator()( uv_fs_t *req ) const {
+                        return Stat( req->statbuf );
+                    }
+                };
+
+#ifdef UV_HAS_COROUTINES
+                //co_await fs->co_stat( path ), resumed on the loop thread from the fs callback
+                inline ::uv::detail::FsAwaiter<StatTransform, decltype( &uv_fs_stat ), std::string> co_stat( std::string path ) {
+                    return ::uv::detail::FsAwaiter<StatTransform, decltype( &uv_fs_stat ), std::string>(
+                        this->loop().get(), StatTransform{}, &uv_fs_stat, std::move( path ));
+                }
+
+                /*
+                 * co_await fs->co_call( uv_fs_open, path, flags, mode ) works with any uv_fs_* function, giving back the
+                 * result of the request or throwing if it's negative. Arguments are kept by value until the request is made.
+                 * */
+                template <typename Functor, typename... Args>
+                inline ::uv::detail::FsAwaiter<::uv::detail::FsResultTransform, Functor, typename std::decay<Args>::type...>
+                co_call( Functor uf, Args &&... args ) {
+                    return ::uv::detail::FsAwaiter<::uv::detail::FsResultTransform, Functor, typename std::decay<Args>::type...>(
+                        this->loop().get(), ::uv::detail::FsResultTransform{}, uf, std::forward<Args>( args )... );
+                }
+#endif
         };
     }
 }
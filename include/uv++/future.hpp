@@ -0,0 +1,390 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_FUTURE_HPP
+#define UV_FUTURE_HPP
+
+#include "fwd.hpp"
+
+#include "expected.hpp"
+
+#include "detail/future.hpp"
+
+#include <mutex>
+#include <condition_variable>
+
+namespace uv {
+    /*
+     * Executors decide where continuations run. Anything with an execute( void (*)( void * ), void * ) member works,
+     * and the pair it's given has to be called exactly once.
+     * */
+    struct InlineExecutor {
+        inline void execute( void (*fn)( void * ), void *arg ) const {
+            fn( arg );
+        }
+    };
+
+    //Runs continuations on a loop thread, through Loop::post
+    struct LoopExecutor {
+        std::shared_ptr<Loop> loop;
+
+        inline void execute( void (*fn)( void * ), void *arg ) const;
+    };
+
+    template <typename T>
+    class Promise;
+
+    namespace detail {
+        struct future_access;
+    }
+
+    /*
+     * Lightweight future for results produced by the library.
+     *
+     * Unlike std::future, the shared state is a single allocation with the result stored inline, and there's no mutex
+     * or condition variable in it. Continuations can be attached with then() without blocking anything, to run inline
+     * on whichever thread completes it, or on a loop. get() still blocks for threads that want to wait.
+     *
+     * Like std::future, it's move-only and its result can be consumed once, by either get() or then().
+     * */
+    template <typename T>
+    class Future {
+        protected:
+            template <typename>
+            friend
+            class Promise;
+
+            template <typename>
+            friend
+            class Future;
+
+            friend struct detail::future_access;
+
+            detail::FutureState<T> *state;
+
+            inline explicit Future( detail::FutureState<T> *s ) noexcept
+                : state( s ) {
+            }
+
+            inline detail::FutureState<T> *take() noexcept {
+                detail::FutureState<T> *s = this->state;
+
+                this->state = nullptr;
+
+                return s;
+            }
+
+            struct WaitNode : detail::FutureNode {
+                std::mutex              mutex;
+                std::condition_variable cv;
+                bool                    done = false;
+
+                inline WaitNode() {
+                    this->run = []( detail::FutureNode *n ) {
+                        WaitNode *w = static_cast<WaitNode *>(n);
+
+                        //Notify with the lock held, since the node lives on the waiting thread's stack
+                        std::lock_guard<std::mutex> lock( w->mutex );
+
+                        w->done = true;
+
+                        w->cv.notify_one();
+                    };
+                }
+            };
+
+            template <typename U>
+            static inline U get_value( detail::FutureState<U> *s ) {
+                return std::move( s->value());
+            }
+
+            static inline void get_value( detail::FutureState<void> * ) {
+            }
+
+            template <typename U>
+            static inline expected<U> get_expected( detail::FutureState<U> *s ) {
+                return expected<U>( std::move( s->value()));
+            }
+
+            static inline expected<void> get_expected( detail::FutureState<void> * ) {
+                return expected<void>();
+            }
+
+            struct releaser {
+                detail::FutureState<T> *s;
+
+                ~releaser() {
+                    s->release();
+                }
+            };
+
+        public:
+            typedef T value_type;
+
+            inline Future() noexcept
+                : state( nullptr ) {
+            }
+
+            inline Future( Future &&other ) noexcept
+                : state( other.take()) {
+            }
+
+            Future( const Future & ) = delete;
+
+            inline Future &operator=( Future &&other ) noexcept {
+                if( this != &other ) {
+                    if( this->state != nullptr ) {
+                        this->state->release();
+                    }
+
+                    this->state = other.take();
+                }
+
+                return *this;
+            }
+
+            inline bool valid() const noexcept {
+                return this->state != nullptr;
+            }
+
+            inline bool is_ready() const noexcept {
+                return this->state != nullptr && this->state->is_ready();
+            }
+
+            //Blocks until the result is ready. Can't be combined with then().
+            void wait() {
+                assert( this->valid());
+
+                if( this->state->is_ready()) {
+                    return;
+                }
+
+                WaitNode w;
+
+                if( this->state->attach( &w )) {
+                    std::unique_lock<std::mutex> lock( w.mutex );
+
+                    w.cv.wait( lock, [&w] {
+                        return w.done;
+                    } );
+                }
+            }
+
+            //Blocks until the result is ready and returns it, or throws the stored exception
+            T get() {
+                this->wait();
+
+                detail::FutureState<T> *s = this->take();
+
+                releaser r{ s };
+
+                if( s->has_error_code()) {
+                    detail::throw_error( s->code());
+
+                } else if( s->has_exception()) {
+                    std::rethrow_exception( s->exception());
+                }
+
+                return get_value( s );
+            }
+
+            /*
+             * Like get, but failures set with an error code are returned rather than thrown. Exceptions still
+             * propagate as they are, since there's no code to give back for them.
+             * */
+            expected<T> result() {
+                this->wait();
+
+                detail::FutureState<T> *s = this->take();
+
+                releaser r{ s };
+
+                if( s->has_error_code()) {
+                    return unexpected( s->code());
+
+                } else if( s->has_exception()) {
+                    std::rethrow_exception( s->exception());
+                }
+
+                return get_expected( s );
+            }
+
+            /*
+             * Runs the functor with the result once it's ready, using the given executor, and returns a future for
+             * what the functor returns. Exceptions and error codes skip the functor and go straight through to the
+             * returned future.
+             * */
+            template <typename Executor, typename Functor>
+            auto then( Executor e, Functor f ) -> Future<typename detail::future_result_of<T>::template type<Functor>> {
+                typedef typename detail::future_result_of<T>::template type<Functor> U;
+
+                typedef detail::ThenState<U, T, Functor, Executor> State;
+
+                assert( this->valid());
+
+                State *s = new State( std::move( f ), std::move( e ), this->take());
+
+                s->start();
+
+                return Future<U>( s );
+            }
+
+            template <typename Functor>
+            inline auto then( std::shared_ptr<Loop> l, Functor f ) -> Future<typename detail::future_result_of<T>::template type<Functor>> {
+                return this->then( LoopExecutor{ std::move( l ) }, std::move( f ));
+            }
+
+            //Runs the continuation inline, on whichever thread completes the future
+            template <typename Functor>
+            inline auto then( Functor f ) -> Future<typename detail::future_result_of<T>::template type<Functor>> {
+                return this->then( InlineExecutor{}, std::move( f ));
+            }
+
+            ~Future() {
+                if( this->state != nullptr ) {
+                    this->state->release();
+                }
+            }
+    };
+
+    namespace detail {
+        //For the combinators and fibers, which attach their own nodes to a future's state
+        struct future_access {
+            template <typename T>
+            static inline FutureState<T> *state( const Future<T> &f ) noexcept {
+                return f.state;
+            }
+        };
+    }
+
+    template <typename T>
+    class Promise {
+        protected:
+            detail::FutureState<T> *state;
+
+            bool retrieved = false;
+            bool satisfied = false;
+
+            inline void check() {
+                if( this->state == nullptr ) {
+                    throw std::future_error( std::future_errc::no_state );
+                }
+
+                if( this->satisfied ) {
+                    throw std::future_error( std::future_errc::promise_already_satisfied );
+                }
+
+                this->satisfied = true;
+            }
+
+        public:
+            inline Promise()
+                : state( new detail::FutureState<T>()) {
+            }
+
+            inline Promise( Promise &&other ) noexcept
+                : state( other.state ), retrieved( other.retrieved ), satisfied( other.satisfied ) {
+                other.state = nullptr;
+            }
+
+            Promise( const Promise & ) = delete;
+
+            inline Promise &operator=( Promise &&other ) noexcept {
+                std::swap( this->state, other.state );
+                std::swap( this->retrieved, other.retrieved );
+                std::swap( this->satisfied, other.satisfied );
+
+                return *this;
+            }
+
+            Future<T> get_future() {
+                if( this->state == nullptr ) {
+                    throw std::future_error( std::future_errc::no_state );
+                }
+
+                if( this->retrieved ) {
+                    throw std::future_error( std::future_errc::future_already_retrieved );
+                }
+
+                this->retrieved = true;
+
+                this->state->add_ref();
+
+                return Future<T>( this->state );
+            }
+
+            template <typename... Args>
+            inline void set_value( Args &&... args ) {
+                this->check();
+
+                this->state->set_value( std::forward<Args>( args )... );
+            }
+
+            inline void set_exception( std::exception_ptr e ) {
+                this->check();
+
+                this->state->set_exception( e );
+            }
+
+            //Fails the future without creating an exception, for errors that are expected to happen often
+            inline void set_error( std::error_code ec ) {
+                assert( bool( ec ));
+
+                this->check();
+
+                this->state->set_error( ec );
+            }
+
+            inline void set_error( int e ) {
+                this->set_error( make_error_code( e ));
+            }
+
+            ~Promise() {
+                if( this->state != nullptr ) {
+                    if( !this->satisfied ) {
+                        this->state->set_exception( std::make_exception_ptr( std::future_error( std::future_errc::broken_promise )));
+                    }
+
+                    this->state->release();
+                }
+            }
+    };
+
+    template <typename T>
+    inline Future<typename std::decay<T>::type> make_ready_future( T &&t ) {
+        Promise<typename std::decay<T>::type> p;
+
+        p.set_value( std::forward<T>( t ));
+
+        return p.get_future();
+    }
+
+    inline Future<void> make_ready_future() {
+        Promise<void> p;
+
+        p.set_value();
+
+        return p.get_future();
+    }
+
+    template <typename T>
+    inline Future<T> make_exception_future( std::exception_ptr e ) {
+        Promise<T> p;
+
+        p.set_exception( e );
+
+        return p.get_future();
+    }
+
+    template <typename T>
+    inline Future<T> make_error_future( std::error_code ec ) {
+        Promise<T> p;
+
+        p.set_error( ec );
+
+        return p.get_future();
+    }
+}
+
+#endif //UV_FUTURE_HPP
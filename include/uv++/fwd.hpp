@@ -36,6 +36,16 @@ namespace uv {
 
     class Signal;
 
+    template <typename>
+    class Channel;
+
+    class SharedRing;
+
+    class SharedRingWriter;
+
+    template <typename>
+    class Batcher;
+
     template <typename, typename>
     class Request;
 
@@ -43,6 +53,8 @@ namespace uv {
 
     class MultiWork;
 
+    class ThreadPool;
+
     namespace fs {
         class File;
 
@@ -66,8 +78,28 @@ namespace uv {
         struct interface_t;
     }
 
+    inline std::shared_ptr<Loop> default_loop();
+
     template <typename... Args>
-    inline UV_DECLTYPE_AUTO schedule( std::shared_ptr<Loop>, Args... );
+    inline UV_DECLTYPE_AUTO schedule( std::shared_ptr<Loop>, Args &&... );
+
+    namespace detail {
+        //For code that has to run on a loop but comes before Loop is complete. These are defined in loop.hpp.
+        inline bool loop_on_thread( Loop * );
+
+        inline uv_loop_t *loop_handle( Loop * );
+
+        inline void loop_post( Loop *, void *, void (*)( void * ));
+
+        class WorkGate;
+
+        inline WorkGate *loop_work_gate( Loop * );
+
+        class RequestMetrics;
+
+        //Null for kinds of requests that aren't tracked
+        inline RequestMetrics *loop_request_metrics( Loop *, uv_req_type );
+    }
 }
 
 #endif //UV_FWD_HPP
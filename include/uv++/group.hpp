@@ -0,0 +1,426 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_GROUP_HPP
+#define UV_GROUP_HPP
+
+#include "loop.hpp"
+
+#include <tuple>
+#include <utility>
+
+namespace uv {
+    class TaskGroup;
+
+    namespace detail {
+        /*
+         * One operation in a TaskGroup, which is also its node in the group's list, so tracking it costs nothing beyond
+         * the operation itself. Only ever touched on the loop thread.
+         * */
+        struct GroupChild {
+            GroupChild *prev = nullptr;
+            GroupChild *next = nullptr;
+
+            //Keeps the group alive until every child has finished
+            std::shared_ptr<TaskGroup> group;
+
+            //Makes the request, returning a negative error if it couldn't
+            int (*start)( GroupChild *, uv_loop_t * ) = nullptr;
+
+            //Cancels the request if it's still queued
+            void (*cancel)( GroupChild * ) = nullptr;
+
+            //Fails the child's future without ever starting it
+            void (*abort)( GroupChild *, std::error_code ) = nullptr;
+
+            virtual ~GroupChild() = default;
+        };
+
+        inline void group_finish( GroupChild *c, std::error_code ec, std::exception_ptr e );
+
+        template <typename R>
+        struct group_deliver {
+            static inline void apply( Outcome<R> &o, Promise<R> &p ) {
+                p.set_value( std::move( o.value()));
+            }
+        };
+
+        template <>
+        struct group_deliver<void> {
+            static inline void apply( Outcome<void> &, Promise<void> &p ) {
+                p.set_value();
+            }
+        };
+
+        template <typename Functor, typename... Args>
+        struct GroupWork final : GroupChild {
+            typedef fn_result_of<Functor> result_type;
+
+            uv_work_t                 req;
+            Functor                   f;
+            std::tuple<Args...>       args;
+            Outcome<result_type>      outcome;
+            Promise<result_type>      promise;
+
+            template <typename F, typename... A>
+            inline GroupWork( F &&fn, A &&... a )
+                : f( std::forward<F>( fn )), args( std::forward<A>( a )... ) {
+                this->req.data = this;
+
+                this->start = []( GroupChild *c, uv_loop_t *l ) {
+                    GroupWork *self = static_cast<GroupWork *>(c);
+
+                    return uv_queue_work( l, &self->req, []( uv_work_t *w ) {
+                        GroupWork *inner = static_cast<GroupWork *>(w->data);
+
+                        dispatch_helper<result_type>::dispatch( inner->outcome, inner->f, inner->args );
+
+                    }, []( uv_work_t *w, int status ) {
+                        GroupWork *inner = static_cast<GroupWork *>(w->data);
+
+                        if( status != 0 ) {
+                            inner->promise.set_error( status );
+
+                            group_finish( inner, make_error_code( status ), nullptr );
+
+                        } else if( inner->outcome.error ) {
+                            inner->promise.set_exception( inner->outcome.error );
+
+                            group_finish( inner, std::error_code(), inner->outcome.error );
+
+                        } else {
+                            group_deliver<result_type>::apply( inner->outcome, inner->promise );
+
+                            group_finish( inner, std::error_code(), nullptr );
+                        }
+                    } );
+                };
+
+                this->cancel = []( GroupChild *c ) {
+                    uv_cancel((uv_req_t *)&static_cast<GroupWork *>(c)->req );
+                };
+
+                this->abort = []( GroupChild *c, std::error_code ec ) {
+                    static_cast<GroupWork *>(c)->promise.set_error( ec );
+                };
+            }
+        };
+
+        template <typename Transform, typename Functor, typename... Args>
+        struct GroupFs final : GroupChild {
+            typedef decltype( std::declval<Transform &>()( std::declval<uv_fs_t *>())) result_type;
+
+            uv_fs_t              req;
+            Transform            transform;
+            Functor              uf;
+            std::tuple<Args...>  args;
+            Promise<result_type> promise;
+
+            template <size_t... I>
+            inline int begin( uv_loop_t *l, std::index_sequence<I...> ) {
+                return this->uf( l, &this->req, fs_arg( std::get<I>( this->args ))..., []( uv_fs_t *r ) {
+                    GroupFs *self = static_cast<GroupFs *>(r->data);
+
+                    std::error_code    ec;
+                    std::exception_ptr e;
+
+                    if( r->result < 0 ) {
+                        ec = make_error_code((int)r->result );
+
+                        self->promise.set_error( ec );
+
+                    } else {
+                        try {
+                            self->promise.set_value( self->transform( r ));
+
+                        } catch( ... ) {
+                            e = std::current_exception();
+
+                            self->promise.set_exception( e );
+                        }
+                    }
+
+                    uv_fs_req_cleanup( r );
+
+                    group_finish( self, ec, e );
+                } );
+            }
+
+            template <typename... A>
+            inline GroupFs( Transform t, Functor fn, A &&... a )
+                : transform( std::move( t )), uf( fn ), args( std::forward<A>( a )... ) {
+                this->req.data = this;
+
+                this->start = []( GroupChild *c, uv_loop_t *l ) {
+                    return static_cast<GroupFs *>(c)->begin( l, std::index_sequence_for<Args...>());
+                };
+
+                this->cancel = []( GroupChild *c ) {
+                    uv_cancel((uv_req_t *)&static_cast<GroupFs *>(c)->req );
+                };
+
+                this->abort = []( GroupChild *c, std::error_code ec ) {
+                    static_cast<GroupFs *>(c)->promise.set_error( ec );
+                };
+            }
+        };
+
+        struct GroupFsResult {
+            inline ssize_t operator()( uv_fs_t *req ) const noexcept {
+                return req->result;
+            }
+        };
+    }
+
+    /*
+     * Scoped fan-out of work and fs operations on a loop.
+     *
+     * Every operation started through the group gets its own future as usual, but the group also keeps track of it.
+     * The first one to fail cancels the rest, with uv_cancel for anything still queued in the thread-pool, and join()
+     * gives a single future that completes once every operation has finished, failing with that first error.
+     *
+     * Operations are linked into the group through their own request objects, so the bookkeeping never allocates.
+     * The group's token can be handed to other operations, like Loop::schedule, to have them cancelled along with it.
+     * */
+    class TaskGroup final : public std::enable_shared_from_this<TaskGroup> {
+        protected:
+            friend void detail::group_finish( detail::GroupChild *, std::error_code, std::exception_ptr );
+
+            std::shared_ptr<Loop> _loop;
+
+            CancellationToken _token;
+            uint64_t          _subscription = 0;
+
+            //Everything from here on is only touched on the loop thread
+            detail::GroupChild *head   = nullptr;
+            size_t             active  = 0;
+            bool               joined  = false;
+            bool               settled = false;
+
+            //The first failure, as an error code if it had one
+            std::error_code    ec;
+            std::exception_ptr error;
+
+            Promise<void> done;
+
+            inline explicit TaskGroup( std::shared_ptr<Loop> l )
+                : _loop( std::move( l )), _token( CancellationToken::make()) {
+            }
+
+            inline bool failed() const noexcept {
+                return bool( this->ec ) || bool( this->error );
+            }
+
+            void cancel_children() {
+                for( detail::GroupChild *c = this->head; c != nullptr; c = c->next ) {
+                    c->cancel( c );
+                }
+            }
+
+            void cancelled( int reason ) {
+                if( !this->failed()) {
+                    this->ec = make_error_code( reason );
+                }
+
+                this->cancel_children();
+            }
+
+            void fail( std::error_code e, std::exception_ptr ex ) {
+                if( !this->failed()) {
+                    this->ec    = e;
+                    this->error = ex;
+                }
+
+                //Comes right back to cancelled(), which finds the failure already recorded
+                this->_token.cancel();
+            }
+
+            void settle() {
+                if( this->settled || !this->joined || this->active != 0 ) {
+                    return;
+                }
+
+                this->settled = true;
+
+                this->_token.unsubscribe( this->_subscription );
+
+                if( this->error ) {
+                    this->done.set_exception( this->error );
+
+                } else if( this->ec ) {
+                    this->done.set_error( this->ec );
+
+                } else {
+                    this->done.set_value();
+                }
+            }
+
+            void launch( detail::GroupChild *c ) {
+                c->next = this->head;
+
+                if( this->head != nullptr ) {
+                    this->head->prev = c;
+                }
+
+                this->head = c;
+
+                ++this->active;
+
+                //Nothing new gets started once the group has been cancelled
+                int res = this->_token.is_cancelled() ? this->_token.reason() : c->start( c, detail::loop_handle( this->_loop.get()));
+
+                if( res < 0 ) {
+                    c->abort( c, make_error_code( res ));
+
+                    detail::group_finish( c, make_error_code( res ), nullptr );
+                }
+            }
+
+            void add( detail::GroupChild *c ) {
+                c->group = this->shared_from_this();
+
+                if( this->_loop->on_loop_thread()) {
+                    this->launch( c );
+
+                } else {
+                    detail::loop_post( this->_loop.get(), c, []( void *p ) {
+                        detail::GroupChild *inner = static_cast<detail::GroupChild *>(p);
+
+                        inner->group->launch( inner );
+                    } );
+                }
+            }
+
+            //Runs the functor on the loop thread, right away if it's already there
+            template <typename Functor>
+            void on_loop( Functor &&f ) {
+                if( this->_loop->on_loop_thread()) {
+                    f();
+
+                } else {
+                    this->_loop->post( std::forward<Functor>( f ));
+                }
+            }
+
+        public:
+            static std::shared_ptr<TaskGroup> make( std::shared_ptr<Loop> l ) {
+                std::shared_ptr<TaskGroup> g( new TaskGroup( std::move( l )));
+
+                std::weak_ptr<TaskGroup> weak = g;
+
+                g->_subscription = g->_token.subscribe( [weak]( int reason ) {
+                    if( auto self = weak.lock()) {
+                        self->on_loop( [self, reason] {
+                            self->cancelled( reason );
+                        } );
+                    }
+                } );
+
+                return g;
+            }
+
+            inline std::shared_ptr<Loop> loop() const noexcept {
+                return this->_loop;
+            }
+
+            //Cancelled when the group is, for tying other operations to it
+            inline const CancellationToken &token() const noexcept {
+                return this->_token;
+            }
+
+            //Cancels everything still queued, and fails join() with the reason unless something already failed
+            inline void cancel( int reason = UV_ECANCELED ) {
+                this->_token.cancel( reason );
+            }
+
+            //Runs the functor on the thread-pool as part of the group, outside of the loop's Work priority classes
+            template <typename Functor, typename... Args>
+            Future<detail::fn_result_of<typename std::decay<Functor>::type>> work( Functor &&f, Args &&... args ) {
+                typedef detail::GroupWork<typename std::decay<Functor>::type, typename std::decay<Args>::type...> Child;
+
+                Child *c = new Child( std::forward<Functor>( f ), std::forward<Args>( args )... );
+
+                auto ret = c->promise.get_future();
+
+                this->add( c );
+
+                return ret;
+            }
+
+            //Any uv_fs_* function, like group->fs( uv_fs_open, path, flags, mode ), giving back the result of the request
+            template <typename Functor, typename... Args>
+            Future<ssize_t> fs( Functor uf, Args &&... args ) {
+                typedef detail::GroupFs<detail::GroupFsResult, Functor, typename std::decay<Args>::type...> Child;
+
+                Child *c = new Child( detail::GroupFsResult{}, uf, std::forward<Args>( args )... );
+
+                auto ret = c->promise.get_future();
+
+                this->add( c );
+
+                return ret;
+            }
+
+            Future<fs::Stat> stat( std::string path ) {
+                typedef detail::GroupFs<fs::Filesystem::StatTransform, decltype( &uv_fs_stat ), std::string> Child;
+
+                Child *c = new Child( fs::Filesystem::StatTransform{}, &uv_fs_stat, std::move( path ));
+
+                auto ret = c->promise.get_future();
+
+                this->add( c );
+
+                return ret;
+            }
+
+            /*
+             * Completes once every operation has finished, including any started after this, or fails with the first
+             * error. Can only be called once.
+             * */
+            Future<void> join() {
+                Future<void> ret = this->done.get_future();
+
+                auto self = this->shared_from_this();
+
+                this->on_loop( [self] {
+                    self->joined = true;
+
+                    self->settle();
+                } );
+
+                return ret;
+            }
+    };
+
+    namespace detail {
+        //Called once a child has finished, on the loop thread
+        inline void group_finish( GroupChild *c, std::error_code ec, std::exception_ptr e ) {
+            //Deleting the child may drop the last reference to the group
+            std::shared_ptr<TaskGroup> g = std::move( c->group );
+
+            if( c->prev != nullptr ) {
+                c->prev->next = c->next;
+
+            } else {
+                g->head = c->next;
+            }
+
+            if( c->next != nullptr ) {
+                c->next->prev = c->prev;
+            }
+
+            delete c;
+
+            --g->active;
+
+            if( ec || e ) {
+                g->fail( ec, e );
+            }
+
+            g->settle();
+        }
+    }
+}
+
+#endif //UV_GROUP_HPP
@@ -12,5 +12,8 @@
 #include "handles/signal.hpp"
 
 #include "handles/async.hpp"
+#include "handles/channel.hpp"
+#include "handles/shared_ring.hpp"
+#include "handles/batcher.hpp"
 
 #endif //UV_HANDLE_HPP
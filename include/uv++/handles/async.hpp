@@ -8,6 +8,7 @@
 #include "base.hpp"
 
 #include "../detail/async.hpp"
+#include "../detail/lockfree.hpp"
 
 namespace uv {
     namespace detail {
@@ -17,6 +18,11 @@ namespace uv {
             static std::shared_future<void> send_void( A * ) {
                 throw ::uv::Exception( "invalid async handle for send_void" );
             }
+
+            template <typename A>
+            static bool send_void_nowait( A * ) noexcept {
+                return false;
+            }
         };
 
         template <>
@@ -25,6 +31,11 @@ namespace uv {
             static std::shared_future<void> send_void( A *d ) {
                 return d->send();
             }
+
+            template <typename A>
+            static bool send_void_nowait( A *d ) {
+                return d->send_nowait();
+            }
         };
     }
 
@@ -45,6 +56,8 @@ namespace uv {
 
         public:
             virtual std::shared_future<void> send_void() = 0;
+
+            virtual bool send_void_nowait() = 0;
     };
 
     template <typename Functor>
@@ -53,44 +66,161 @@ namespace uv {
             typedef typename Async::handle_t handle_t;
 
         protected:
-            typedef typename Handle<uv_async_t, AsyncDetail<Functor>>::HandleData HandleData;
-
-            std::mutex m;
+            typedef typename Async::HandleData HandleData;
 
-            typedef detail::AsyncContinuation<Functor, Async> Continuation;
+            typedef detail::Continuation<Functor, Async> Continuation;
 
             typedef typename detail::function_traits<Functor>::result_type result_type;
-            typedef typename detail::function_traits<Functor>::tuple_type  tuple_type;
+
+            //Arguments are stored by value in the send slots until the loop gets to them
+            typedef typename detail::decay_tuple<typename detail::function_traits<Functor>::tuple_type>::type tuple_type;
+
+            typedef detail::ContinuationNeedsSelf<Functor, Async> needs_self;
 
             enum {
-                arity = detail::function_traits<Functor>::arity -
-                        ( detail::ContinuationNeedsSelf<Functor, Async>::value )
+                arity = detail::function_traits<Functor>::arity - ( needs_self::value )
+            };
+
+            typedef std::promise<result_type> promise_type;
+
+            /*
+             * Every send gets its own slot for its arguments and result, so concurrent sends never overwrite each
+             * other. Slots are reused through a lock-free pool, so once it has grown to the peak number of
+             * in-flight sends, send_nowait doesn't allocate at all.
+             *
+             * send hands back a std::shared_future, so it still allocates exactly one shared state per call. The
+             * promise is only constructed in its slot for that send, rather than kept around in every pooled slot,
+             * since a default constructed std::promise allocates a state of its own that would just be thrown away.
+             * */
+            struct SendSlot {
+                typename std::aligned_storage<sizeof( tuple_type ), alignof( tuple_type )>::type     storage;
+                typename std::aligned_storage<sizeof( promise_type ), alignof( promise_type )>::type result_storage;
+
+                //False for send_nowait, where no promise is created and nobody is waiting on the result
+                bool wants_result;
+
+                inline tuple_type &args() noexcept {
+                    return *reinterpret_cast<tuple_type *>(&this->storage);
+                }
+
+                //Only constructed while wants_result is set
+                inline promise_type &result() noexcept {
+                    return *reinterpret_cast<promise_type *>(&this->result_storage);
+                }
             };
 
-            std::atomic_bool is_sending;
+            typedef detail::SlotPool<SendSlot>   SlotPool;
+            typedef typename SlotPool::Slot      Slot;
+            typedef detail::MPSCList<Slot>       SlotList;
+
+            SlotPool slots;
+            SlotList pending;
+
+            template <typename... Args>
+            inline void construct_args( Slot *s, std::true_type, Args &&... args ) {
+                new( &s->value.storage ) tuple_type( std::static_pointer_cast<Async>( this->shared_from_this()), std::forward<Args>( args )... );
+            }
+
+            template <typename... Args>
+            inline void construct_args( Slot *s, std::false_type, Args &&... args ) {
+                new( &s->value.storage ) tuple_type( std::forward<Args>( args )... );
+            }
+
+            inline void release_slot( Slot *s ) noexcept {
+                s->value.args().~tuple_type();
+
+                if( s->value.wants_result ) {
+                    s->value.result().~promise_type();
+                }
+
+                this->slots.release( s );
+            }
+
+            //Returns the result of waking up the loop, or zero if it didn't have to
+            inline int enqueue( Slot *s ) noexcept {
+                /*
+                 * Only the send that finds the queue empty has to wake up the loop. Everything else queued up
+                 * before the loop gets around to it is handled in the same callback.
+                 * */
+                if( this->pending.push( s )) {
+                    return uv_async_send( this->handle());
+                }
+
+                return 0;
+            }
+
+            //Queues up a send with a result, once a SendGuard has been entered, and sets res from waking up the loop
+            template <typename... Args>
+            std::shared_future<result_type> queue_send( int &res, Args &&... args ) {
+                Slot *s = this->slots.acquire();
+
+                try {
+                    this->construct_args( s, std::integral_constant<bool, needs_self::value>(), std::forward<Args>( args )... );
+
+                } catch( ... ) {
+                    this->slots.release( s );
+
+                    throw;
+                }
+
+                s->value.wants_result = false;
+
+                try {
+                    new( &s->value.result_storage ) promise_type();
+
+                } catch( ... ) {
+                    this->release_slot( s );
+
+                    throw;
+                }
+
+                s->value.wants_result = true;
+
+                std::shared_future<result_type> ret = s->value.result().get_future();
+
+                res = this->enqueue( s );
+
+                return ret;
+            }
+
+            /*
+             * Runs every send queued up since the last wakeup, in the order they were sent.
+             * */
+            void drain( Continuation *c ) {
+                Slot *s = this->pending.take_all();
+
+                while( s != nullptr ) {
+                    Slot *next = s->next;
+
+                    if( !s->value.wants_result ) {
+                        if( !this->closing ) {
+                            detail::dispatch_nowait( c->f, s->value.args());
+                        }
+
+                    } else if( this->closing ) {
+                        s->value.result().set_exception( std::make_exception_ptr( ::uv::Exception( "async handle has been closed" )));
+
+                    } else {
+                        detail::dispatch_helper<result_type>::dispatch( s->value.result(), c->f, s->value.args());
+                    }
+
+                    this->release_slot( s );
+
+                    s = next;
+                }
+            }
 
         public:
             inline void start( Functor f ) {
                 this->internal_data->continuation = std::make_shared<Continuation>( f );
 
-                this->is_sending = false;
-
                 uv_async_init( this->loop_handle(), this->handle(), []( uv_async_t *h ) {
                     if( h->data != nullptr ) {
                         std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
 
                         if( auto data = d->lock()) {
-                            if( auto self = data->self.lock()) {
-                                std::lock_guard<std::mutex> lock( self->m );
-
-                                if( self->closing ) {
-                                    data->template cont<Continuation>()->set_exception( ::uv::Exception( "async handle has been closed" ));
-
-                                } else {
-                                    data->template cont<Continuation>()->dispatch();
-                                }
-
-                                self->is_sending = false;
+                            if( auto self = std::static_pointer_cast<AsyncDetail>( data->self.lock())) {
+                                self->drain( data->template cont<Continuation>());
                             }
 
                         } else {
@@ -103,55 +233,131 @@ namespace uv {
             /*
              * The enable_if is to generate slightly more appealing error messages when there are
              * incorrect number of arguments given. That way it fails here instead of deep into the details.
+             *
+             * Arguments are forwarded straight into the send slot, so rvalues are moved rather than copied
+             * and move-only types can be sent.
              * */
             template <typename... Args>
             typename std::enable_if<sizeof...( Args ) == arity, std::shared_future<result_type>>::type
-            send( Args... args ) {
-                /*
-                 * The mutex is here because by the time it acquires the lock there is a low chance the Async handle
-                 * will be closing.
-                 * */
-                std::lock_guard<std::mutex> lock( this->m );
+            send( Args &&... args ) {
+                SendGuard guard( this );
 
-                if( this->closing ) {
+                if( !guard ) {
                     throw ::uv::Exception( "async handle closed" );
 
                 } else {
-                    bool expect_sending = false;
-
-                    this->is_sending.compare_exchange_strong( expect_sending, true );
+                    int res;
 
-                    Continuation *c = this->internal_data->template cont<Continuation>();
+                    std::shared_future<result_type> ret = this->queue_send( res, std::forward<Args>( args )... );
 
-                    auto ret = c->init( std::static_pointer_cast<Async>( this->shared_from_this()), std::forward<Args>( args )... );
-
-                    /*
-                     * So even with the mutex and stuff above, there is a slight chance libuv will still occasionally
-                     * try to run the async task twice if you queue it up many times really fast.
-                     *
-                     * I'm guessing it marks the task as "done" before it runs the callback, so in the time between
-                     * the callback starting and it finishing, queueing up another uv_async_send could potentially
-                     * cause it to run again. So just keep track of it with our own flag so it doesn't confuse it.
-                     * */
-                    if( !expect_sending ) {
-                        uv_async_send( this->handle());
+                    if( res < 0 ) {
+                        throw ::uv::Exception( res );
                     }
 
                     return ret;
                 }
             }
 
+            /*
+             * Like send, but errors are put in ec instead of thrown. Sending to a closed handle sets UV_ECANCELED,
+             * running out of memory for the send sets UV_ENOMEM, and either returns an invalid future. If the loop
+             * couldn't be woken up, ec is set but the future is still returned, since the send was queued.
+             *
+             * Anything else thrown while copying the arguments is still thrown.
+             * */
+            template <typename... Args>
+            typename std::enable_if<sizeof...( Args ) == arity, std::shared_future<result_type>>::type
+            send( std::error_code &ec, Args &&... args ) {
+                SendGuard guard( this );
+
+                if( !guard ) {
+                    ec = make_error_code( UV_ECANCELED );
+
+                    return std::shared_future<result_type>();
+                }
+
+                int res;
+
+                std::shared_future<result_type> ret;
+
+                try {
+                    ret = this->queue_send( res, std::forward<Args>( args )... );
+
+                } catch( const std::bad_alloc & ) {
+                    ec = make_error_code( UV_ENOMEM );
+
+                    return std::shared_future<result_type>();
+                }
+
+                detail::set_error( ec, res );
+
+                return ret;
+            }
+
+            /*
+             * Fire-and-forget version of send. Nothing is allocated for the result, and the return value is simply
+             * whether it was queued up. Sending to a closed handle returns false instead of throwing.
+             * */
+            template <typename... Args>
+            typename std::enable_if<sizeof...( Args ) == arity, bool>::type
+            send_nowait( Args &&... args ) {
+                SendGuard guard( this );
+
+                if( !guard ) {
+                    return false;
+                }
+
+                Slot *s = this->slots.acquire();
+
+                try {
+                    this->construct_args( s, std::integral_constant<bool, needs_self::value>(), std::forward<Args>( args )... );
+
+                } catch( ... ) {
+                    this->slots.release( s );
+
+                    throw;
+                }
+
+                s->value.wants_result = false;
+
+                this->enqueue( s );
+
+                return true;
+            }
+
             template <typename... Args>
             inline typename std::enable_if<sizeof...( Args ) == arity, std::future<result_type>>::type
-            defer_send( Args... args ) {
-                return std::async( std::launch::deferred, [this]( Args &&... inner_args ) {
-                    return this->send( std::forward<Args>( inner_args )... ).get();
+            defer_send( Args &&... args ) {
+                //std::async keeps its own decayed copies of the arguments, and passes them on as rvalues
+                return std::async( std::launch::deferred, [this]( typename std::decay<Args>::type &&... inner_args ) {
+                    return this->send( std::move( inner_args )... ).get();
                 }, std::forward<Args>( args )... );
             };
 
             inline std::shared_future<void> send_void() override {
                 return detail::send_void_helper<result_type, arity>::send_void( this );
             }
+
+            inline bool send_void_nowait() override {
+                return detail::send_void_helper<result_type, arity>::send_void_nowait( this );
+            }
+
+            ~AsyncDetail() {
+                //Anything still queued up will never be run, so let whoever is waiting on it know
+                Slot *s = this->pending.take_all();
+
+                while( s != nullptr ) {
+                    Slot *next = s->next;
+
+                    if( s->value.wants_result ) {
+                        s->value.result().set_exception( std::make_exception_ptr( ::uv::Exception( "async handle has been closed" )));
+                    }
+
+                    this->release_slot( s );
+
+                    s = next;
+                }
+            }
     };
 }
 
@@ -12,6 +12,7 @@
 #include "../detail/handle.hpp"
 
 #include <future>
+#include <thread>
 
 namespace uv {
     template <typename H, typename D>
@@ -26,6 +27,13 @@ namespace uv {
         //Only used for close callbacks
         std::shared_ptr<void> close_continuation;
 
+        /*
+         * Re-arms the libuv side of a started handle with the existing continuation.
+         *
+         * Set by each start function, and used to bring the handle back up on another loop after a migration.
+         * */
+        std::function<void( D * )> resume;
+
         /*
          * This is kept here to ensure a circular reference between the handle and the handle data
          * */
@@ -78,12 +86,77 @@ namespace uv {
             std::shared_ptr<handle_t>   _handle;
             std::atomic_bool            closing;
 
+            //Threads part way through sending to the handle from outside the loop
+            std::atomic<size_t> senders;
+
+            /*
+             * Held for as long as a thread is sending to the handle, like with uv_async_send. Entering fails once the
+             * handle is closing, and close waits for anyone already in to leave before it hands the handle to uv_close.
+             *
+             * Both sides store then load, so those are sequentially consistent or they could miss each other.
+             * */
+            class SendGuard {
+                protected:
+                    HandleBase *base;
+                    bool       entered;
+
+                public:
+                    inline explicit SendGuard( HandleBase *b ) noexcept
+                        : base( b ) {
+                        b->senders.fetch_add( 1 );
+
+                        this->entered = !b->closing.load();
+
+                        if( !this->entered ) {
+                            b->senders.fetch_sub( 1, std::memory_order_release );
+                        }
+                    }
+
+                    SendGuard( const SendGuard & ) = delete;
+
+                    inline explicit operator bool() const noexcept {
+                        return this->entered;
+                    }
+
+                    ~SendGuard() {
+                        if( this->entered ) {
+                            this->base->senders.fetch_sub( 1, std::memory_order_release );
+                        }
+                    }
+            };
+
+            //Only after closing has been set. Senders never block inside, so this doesn't wait long.
+            inline void wait_for_senders() const noexcept {
+                while( this->senders.load() != 0 ) {
+                    std::this_thread::yield();
+                }
+            }
+
             //Implemented in derived classes
             virtual void _init() = 0;
 
             virtual void _stop() = 0;
 
+            /*
+             * Stops the handle before it is closed for a migration. Derived classes can override this to
+             * record whatever state resume needs later on, like the time left on a timer.
+             * */
+            virtual void _suspend() {
+                this->_stop();
+            }
+
+            /*
+             * Runs on the loop thread right before close hands the handle to uv_close, once nothing more can be sent
+             * to it. Derived classes can override this to deliver anything they're still holding onto.
+             * */
+            virtual void _closing() {
+            }
+
         public:
+            inline HandleBase() noexcept
+                : closing( false ), senders( 0 ) {
+            }
+
             inline void init( std::shared_ptr<Loop> l ) {
                 this->_loop_init( l );
 
@@ -150,6 +223,13 @@ namespace uv {
             template <typename Functor>
             std::shared_future<void> close( Functor );
 
+        protected:
+            friend class Loop;
+
+            std::shared_future<void> migrate( std::shared_ptr<Loop> );
+
+        public:
+
             inline handle_kind guess_handle_kind() const noexcept {
                 return (handle_kind)uv_guess_handle( this->handle()->type );
             }
@@ -0,0 +1,292 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_BATCHER_HANDLE_HPP
+#define UV_BATCHER_HANDLE_HPP
+
+#include "base.hpp"
+
+#include "../detail/span.hpp"
+
+#include <vector>
+#include <mutex>
+
+namespace uv {
+    namespace detail {
+        //Anything with a size(), like strings and buffers, counts that many bytes, and everything else counts sizeof
+        template <typename T>
+        inline auto batch_bytes( const T &t, int ) noexcept -> decltype( size_t( t.size())) {
+            return t.size();
+        }
+
+        template <typename T>
+        inline size_t batch_bytes( const T &, long ) noexcept {
+            return sizeof( T );
+        }
+    }
+
+    /*
+     * Accumulates items from any thread and hands them to the loop in batches.
+     *
+     * A batch is flushed when it reaches the item limit, the byte limit, or the maximum delay after its first item,
+     * whichever comes first. There are two buffers, so producers keep adding to one while the callback works through
+     * the other, and the timer is only armed when a batch starts rather than once per item.
+     *
+     * Closing the batcher flushes whatever was added before it, so nothing accepted by add() is dropped.
+     * */
+    template <typename T>
+    class Batcher final : public Handle<uv_timer_t, Batcher<T>> {
+        public:
+            typedef typename Handle<uv_timer_t, Batcher<T>>::handle_t handle_t;
+
+            typedef T value_type;
+
+        protected:
+            typedef typename Handle<uv_timer_t, Batcher<T>>::HandleData HandleData;
+
+            std::mutex     mutex;
+            std::vector<T> incoming;
+            size_t         incoming_bytes = 0;
+
+            //Set once a flush has been asked for, so a burst of producers only schedules one
+            bool flush_pending = false;
+
+            //Only touched on the loop thread
+            std::vector<T> outgoing;
+
+            /*
+             * Set while the callback is working through outgoing. A flush asked for from inside the callback, like an
+             * add() that fills the batch, can't swap the buffers out from under it, so it's done once this one returns.
+             * */
+            bool flushing = false;
+            bool reflush  = false;
+
+            size_t   max_items = 0;
+            size_t   max_bytes = 0;
+            uint64_t max_delay = 0;
+
+            void (*flush_fn)( Batcher * )   = nullptr;
+            void (*flush_once)( Batcher * ) = nullptr;
+
+            inline void _init() noexcept {
+                uv_timer_init( this->loop_handle(), this->handle());
+            }
+
+            inline void _stop() noexcept {
+                uv_timer_stop( this->handle());
+            }
+
+            //add() already refuses new items by now, so this is the last of them
+            void _closing() override {
+                if( this->flush_fn != nullptr ) {
+                    this->flush_fn( this );
+                }
+            }
+
+            //Starts the delay timer for a new batch, on the loop thread
+            void arm() {
+                bool has_items;
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    has_items = !this->incoming.empty();
+                }
+
+                if( has_items && !uv_is_active((uv_handle_t *)this->handle())) {
+                    uv_timer_start( this->handle(), []( uv_timer_t *h ) {
+                        std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
+
+                        if( d != nullptr ) {
+                            if( auto data = d->lock()) {
+                                if( auto self = data->self.lock()) {
+                                    self->flush_fn( self.get());
+                                }
+
+                            } else {
+                                HandleData::cleanup( h, d );
+                            }
+                        }
+                    }, this->max_delay, 0 );
+                }
+            }
+
+            template <typename Functor>
+            void run_on_loop( Functor f ) {
+                if( this->on_loop_thread()) {
+                    f( this );
+
+                } else {
+                    auto self = this->internal_data->self.lock();
+
+                    this->loop()->post( [self, f] {
+                        f( self.get());
+                    } );
+                }
+            }
+
+            template <typename... Args>
+            bool do_add( Args &&... args ) {
+                bool first, full;
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    if( this->closing ) {
+                        return false;
+                    }
+
+                    this->incoming.emplace_back( std::forward<Args>( args )... );
+
+                    this->incoming_bytes += detail::batch_bytes( this->incoming.back(), 0 );
+
+                    first = this->incoming.size() == 1;
+                    full  = !this->flush_pending &&
+                            ( this->incoming.size() >= this->max_items || this->incoming_bytes >= this->max_bytes );
+
+                    if( full ) {
+                        this->flush_pending = true;
+                    }
+                }
+
+                if( full ) {
+                    this->run_on_loop( []( Batcher *self ) {
+                        self->flush_fn( self );
+                    } );
+
+                } else if( first ) {
+                    this->run_on_loop( []( Batcher *self ) {
+                        self->arm();
+                    } );
+                }
+
+                return true;
+            }
+
+        public:
+            template <typename Functor,
+                      typename _Rep, typename _Period>
+            void start( Functor f,
+                        size_t max_items,
+                        size_t max_bytes,
+                        const std::chrono::duration<_Rep, _Period> &max_delay ) {
+                typedef std::chrono::duration<uint64_t, std::milli> millis;
+
+                typedef detail::Continuation<Functor, Batcher<T>> Cont;
+
+                this->internal_data->continuation = std::make_shared<Cont>( f );
+
+                this->max_items = max_items == 0 ? 1 : max_items;
+                this->max_bytes = max_bytes == 0 ? SIZE_MAX : max_bytes;
+                this->max_delay = std::chrono::duration_cast<millis>( max_delay ).count();
+
+                this->incoming.reserve( this->max_items );
+                this->outgoing.reserve( this->max_items );
+
+                this->flush_fn = []( Batcher *self ) {
+                    if( self->flushing ) {
+                        self->reflush = true;
+
+                        return;
+                    }
+
+                    struct guard {
+                        Batcher *self;
+
+                        ~guard() {
+                            self->flushing = false;
+                        }
+                    } g{ self };
+
+                    self->flushing = true;
+
+                    do {
+                        self->reflush = false;
+
+                        self->flush_once( self );
+                    } while( self->reflush );
+                };
+
+                this->flush_once = []( Batcher *self ) {
+                    {
+                        std::lock_guard<std::mutex> lock( self->mutex );
+
+                        //Swap buffers so producers can carry on while this batch is handled
+                        self->incoming.swap( self->outgoing );
+
+                        self->incoming_bytes = 0;
+                        self->flush_pending  = false;
+                    }
+
+                    uv_timer_stop( self->handle());
+
+                    if( !self->outgoing.empty()) {
+                        auto data = self->internal_data;
+
+                        if( auto s = data->self.lock()) {
+                            /*
+                             * Producers don't wait for a flush to be picked up, so if the loop fell behind there may be
+                             * more than one batch worth here. Hand it over in pieces that respect the limits.
+                             * */
+                            T      *first = self->outgoing.data();
+                            T      *last  = first + self->outgoing.size();
+                            T      *it    = first;
+                            size_t bytes  = 0;
+
+                            while( it != last ) {
+                                bytes += detail::batch_bytes( *it, 0 );
+
+                                ++it;
+
+                                if( it == last || (size_t)( it - first ) >= self->max_items || bytes >= self->max_bytes ) {
+                                    data->template cont<Cont>()->dispatch( s, Span<T>( first, (size_t)( it - first )));
+
+                                    first = it;
+                                    bytes = 0;
+                                }
+                            }
+                        }
+
+                        self->outgoing.clear();
+                    }
+                };
+
+                this->internal_data->resume = []( Batcher *self ) {
+                    self->arm();
+                };
+            }
+
+            /*
+             * Adds an item from any thread. Returns false if the batcher is closed.
+             * */
+            inline bool add( T &&t ) {
+                return this->do_add( std::move( t ));
+            }
+
+            inline bool add( const T &t ) {
+                return this->do_add( t );
+            }
+
+            template <typename... Args>
+            inline bool emplace( Args &&... args ) {
+                return this->do_add( std::forward<Args>( args )... );
+            }
+
+            //Flushes whatever has been added so far, from any thread
+            inline void flush() {
+                this->run_on_loop( []( Batcher *self ) {
+                    self->flush_fn( self );
+                } );
+            }
+
+            //Approximate, since producers may be adding at the same time
+            inline size_t size() {
+                std::lock_guard<std::mutex> lock( this->mutex );
+
+                return this->incoming.size();
+            }
+    };
+}
+
+#endif //UV_BATCHER_HANDLE_HPP
@@ -0,0 +1,265 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_CHANNEL_HANDLE_HPP
+#define UV_CHANNEL_HANDLE_HPP
+
+#include "base.hpp"
+
+#include "../detail/span.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace uv {
+    /*
+     * Typed multiple-producer channel into the loop.
+     *
+     * Any thread can push values into it, and the loop callback receives every value pushed since the last wakeup
+     * as one contiguous batch. Values are kept in a fixed size ring buffer, so pushing never allocates, and pushing
+     * into a full channel fails instead of blocking so producers can back off.
+     * */
+    template <typename T>
+    class Channel final : public Handle<uv_async_t, Channel<T>> {
+        public:
+            typedef typename Handle<uv_async_t, Channel<T>>::handle_t handle_t;
+
+            typedef T value_type;
+
+        protected:
+            typedef typename Handle<uv_async_t, Channel<T>>::HandleData HandleData;
+
+            /*
+             * Each cell has a sequence number that says whether it's ready to be written for a given position,
+             * or ready to be read. This is the bounded queue by Dmitry Vyukov, with only one consumer.
+             * */
+            struct Cell {
+                std::atomic<size_t> sequence;
+
+                typename std::aligned_storage<sizeof( T ), alignof( T )>::type storage;
+
+                inline T &value() noexcept {
+                    return *reinterpret_cast<T *>(&this->storage);
+                }
+            };
+
+            std::unique_ptr<Cell[]> cells;
+            size_t                  mask = 0;
+
+            //Producers and the consumer are kept on separate cache lines
+            alignas( 64 ) std::atomic<size_t> tail;
+            alignas( 64 ) std::atomic<size_t> head;
+
+            std::atomic_bool signalled;
+
+            //Reused for every batch, so it only allocates until it reaches the channel capacity
+            std::vector<T> batch;
+
+            inline void _init() noexcept {
+                //No-op for uv_async_t
+            }
+
+            inline void _stop() noexcept {
+                //Also a no-op for uv_async_t
+            }
+
+            //Moves everything available out of the ring and into the batch
+            void take_batch() {
+                size_t pos = this->head.load( std::memory_order_relaxed );
+
+                while( this->batch.size() <= this->mask ) {
+                    Cell &c = this->cells[pos & this->mask];
+
+                    if( c.sequence.load( std::memory_order_acquire ) != pos + 1 ) {
+                        break;
+                    }
+
+                    this->batch.push_back( std::move( c.value()));
+
+                    c.value().~T();
+
+                    //Mark the cell as writable again for the next lap around the ring
+                    c.sequence.store( pos + this->mask + 1, std::memory_order_release );
+
+                    ++pos;
+                }
+
+                this->head.store( pos, std::memory_order_relaxed );
+            }
+
+            template <typename... Args>
+            bool do_push( Args &&... args ) {
+                //Keeps close from getting to uv_close until the uv_async_send below is done
+                typename Channel::SendGuard guard( this );
+
+                if( !guard ) {
+                    return false;
+                }
+
+                size_t pos = this->tail.load( std::memory_order_relaxed );
+                Cell   *c;
+
+                for( ;; ) {
+                    c = &this->cells[pos & this->mask];
+
+                    size_t   seq = c->sequence.load( std::memory_order_acquire );
+                    intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+
+                    if( dif == 0 ) {
+                        //Uncontended, this succeeds the first time around
+                        if( this->tail.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed )) {
+                            break;
+                        }
+
+                    } else if( dif < 0 ) {
+                        //The consumer hasn't caught up to this cell yet, so the channel is full
+                        return false;
+
+                    } else {
+                        pos = this->tail.load( std::memory_order_relaxed );
+                    }
+                }
+
+                new( &c->storage ) T( std::forward<Args>( args )... );
+
+                c->sequence.store( pos + 1, std::memory_order_release );
+
+                /*
+                 * Publishing the value and then checking the flag races with the loop clearing the flag and then
+                 * checking for values. Without a full fence on both sides each could miss the other's store, leaving
+                 * the value sitting there with nobody signalled.
+                 * */
+                std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                /*
+                 * Only wake up the loop if nobody else has since it last drained the channel.
+                 * The relaxed load first avoids bouncing the cache line around when it's already been signalled.
+                 * */
+                if( !this->signalled.load( std::memory_order_relaxed ) && !this->signalled.exchange( true, std::memory_order_acq_rel )) {
+                    uv_async_send( this->handle());
+                }
+
+                return true;
+            }
+
+        public:
+            template <typename Functor>
+            void start( Functor f, size_t capacity = UV_CHANNEL_CAPACITY ) {
+                typedef detail::Continuation<Functor, Channel<T>> Cont;
+
+                //Round the capacity up to a power of two so positions can just be masked
+                size_t size = 2;
+
+                while( size < capacity ) {
+                    size <<= 1;
+                }
+
+                this->cells.reset( new Cell[size] );
+                this->mask = size - 1;
+
+                for( size_t i = 0; i < size; ++i ) {
+                    this->cells[i].sequence.store( i, std::memory_order_relaxed );
+                }
+
+                this->head.store( 0, std::memory_order_relaxed );
+                this->tail.store( 0, std::memory_order_relaxed );
+                this->signalled = false;
+
+                this->batch.reserve( size );
+
+                this->internal_data->continuation = std::make_shared<Cont>( f );
+
+                uv_async_init( this->loop_handle(), this->handle(), []( uv_async_t *h ) {
+                    std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
+
+                    if( d != nullptr ) {
+                        if( auto data = d->lock()) {
+                            if( auto self = data->self.lock()) {
+                                //Clear the flag before draining, so anything pushed during the drain wakes the loop again
+                                self->signalled.store( false, std::memory_order_release );
+
+                                //Pairs with the fence in do_push
+                                std::atomic_thread_fence( std::memory_order_seq_cst );
+
+                                self->take_batch();
+
+                                if( !self->batch.empty()) {
+                                    data->template cont<Cont>()->dispatch( self, Span<T>( self->batch.data(), self->batch.size()));
+
+                                    self->batch.clear();
+                                }
+
+                                /*
+                                 * At most one capacity worth of values is handled per wakeup so a busy producer
+                                 * can't starve the rest of the loop. If there's more, come back around for it.
+                                 * */
+                                if( !self->empty() && !self->signalled.exchange( true, std::memory_order_acq_rel )) {
+                                    uv_async_send( h );
+                                }
+                            }
+
+                        } else {
+                            HandleData::cleanup( h, d );
+                        }
+                    }
+                } );
+            }
+
+            /*
+             * Pushes a value into the channel from any thread.
+             *
+             * Returns false if the channel is full or closed. That's the backpressure signal, and the value is left
+             * untouched so it can be pushed again later.
+             * */
+            inline bool push( T &&t ) {
+                return this->do_push( std::move( t ));
+            }
+
+            inline bool push( const T &t ) {
+                return this->do_push( t );
+            }
+
+            template <typename... Args>
+            inline bool emplace( Args &&... args ) {
+                return this->do_push( std::forward<Args>( args )... );
+            }
+
+            inline size_t capacity() const noexcept {
+                return this->mask + 1;
+            }
+
+            //Approximate number of values waiting, since producers may be pushing at the same time
+            inline size_t size() const noexcept {
+                size_t t = this->tail.load( std::memory_order_relaxed );
+                size_t h = this->head.load( std::memory_order_relaxed );
+
+                return t > h ? t - h : 0;
+            }
+
+            //Only meaningful on the loop thread
+            inline bool empty() const noexcept {
+                size_t h = this->head.load( std::memory_order_relaxed );
+
+                return this->cells[h & this->mask].sequence.load( std::memory_order_acquire ) != h + 1;
+            }
+
+            inline bool full() const noexcept {
+                return this->size() >= this->capacity();
+            }
+
+            ~Channel() {
+                if( this->cells ) {
+                    size_t pos = this->head.load( std::memory_order_relaxed );
+
+                    while( this->cells[pos & this->mask].sequence.load( std::memory_order_acquire ) == pos + 1 ) {
+                        this->cells[pos & this->mask].value().~T();
+
+                        ++pos;
+                    }
+                }
+            }
+    };
+}
+
+#endif //UV_CHANNEL_HANDLE_HPP
@@ -30,7 +30,7 @@ namespace uv {
 
                 this->internal_data->continuation = std::make_shared<Cont>( f );
 
-                uv_idle_start( this->handle(), []( uv_idle_t *h ) {
+                auto cb = []( uv_idle_t *h ) {
                     std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
 
                     if( d != nullptr ) {
@@ -43,7 +43,13 @@ namespace uv {
                             HandleData::cleanup( h, d );
                         }
                     }
-                } );
+                };
+
+                uv_idle_start( this->handle(), cb );
+
+                this->internal_data->resume = [cb]( Idle *self ) {
+                    uv_idle_start( self->handle(), cb );
+                };
             }
     };
 }
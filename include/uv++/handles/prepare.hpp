@@ -30,7 +30,7 @@ namespace uv {
 
                 this->internal_data->continuation = std::make_shared<Cont>( f );
 
-                uv_prepare_start( this->handle(), []( uv_prepare_t *h ) {
+                auto cb = []( uv_prepare_t *h ) {
                     std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
 
                     if( d != nullptr ) {
@@ -43,7 +43,13 @@ namespace uv {
                             HandleData::cleanup( h, d );
                         }
                     }
-                } );
+                };
+
+                uv_prepare_start( this->handle(), cb );
+
+                this->internal_data->resume = [cb]( Prepare *self ) {
+                    uv_prepare_start( self->handle(), cb );
+                };
             }
     };
 }
@@ -0,0 +1,638 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_SHARED_RING_HANDLE_HPP
+#define UV_SHARED_RING_HANDLE_HPP
+
+#include "base.hpp"
+
+#include "../detail/span.hpp"
+
+#ifdef __linux__
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cassert>
+#include <string>
+#include <atomic>
+
+namespace uv {
+    namespace detail {
+        /*
+         * Layout of the shared memory used by SharedRing and SharedRingWriter.
+         *
+         * Everything in here is accessed by multiple processes, so it's only ever lock-free atomics and
+         * plain data. Positions are absolute byte counts that only ever increase, and are masked by capacity - 1.
+         * */
+        struct SharedRingHeader {
+            enum : uint64_t {
+                MAGIC = 0x75767070524e4731ull //"uvppRNG1"
+            };
+
+            uint64_t magic;
+            uint64_t capacity;
+
+            //Producers reserve space by moving this forward
+            alignas( 64 ) std::atomic<uint64_t> reserved;
+
+            //The consumer frees space by moving this forward
+            alignas( 64 ) std::atomic<uint64_t> consumed;
+
+            //Set by the consumer when it's waiting on the eventfd, so producers only write to it when needed
+            alignas( 64 ) std::atomic<uint32_t> idle;
+        };
+
+        struct SharedRingRecord {
+            enum : uint32_t {
+                PADDING = 1
+            };
+
+            //Position + 1 once the record is committed. Zero, or some other position, until then.
+            std::atomic<uint64_t> sequence;
+
+            uint32_t size;
+            uint32_t flags;
+        };
+
+        static_assert( sizeof( SharedRingRecord ) == 16, "shared ring records must be 16 bytes" );
+
+        inline constexpr size_t shared_ring_data_offset() noexcept {
+            return ( sizeof( SharedRingHeader ) + 63 ) & ~size_t( 63 );
+        }
+
+        inline constexpr uint64_t shared_ring_record_size( size_t payload ) noexcept {
+            return ( sizeof( SharedRingRecord ) + payload + 15 ) & ~uint64_t( 15 );
+        }
+
+        /*
+         * Just the mapping and file descriptors, shared by both ends.
+         * */
+        class SharedRingMapping {
+            protected:
+                int              memory_fd = -1;
+                int              event_fd  = -1;
+                void             *base     = nullptr;
+                size_t           length    = 0;
+                SharedRingHeader *header   = nullptr;
+                char             *ring     = nullptr;
+                uint64_t         mask      = 0;
+
+                inline int map( int fd, size_t len ) noexcept {
+                    void *p = mmap( nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+
+                    if( p == MAP_FAILED ) {
+                        return -errno;
+                    }
+
+                    this->memory_fd = fd;
+                    this->base      = p;
+                    this->length    = len;
+                    this->header    = static_cast<SharedRingHeader *>(p);
+                    this->ring      = static_cast<char *>(p) + shared_ring_data_offset();
+
+                    return 0;
+                }
+
+                inline SharedRingRecord *record_at( uint64_t pos ) const noexcept {
+                    return reinterpret_cast<SharedRingRecord *>(this->ring + ( pos & this->mask ));
+                }
+
+            public:
+                //Takes over another mapping's memory and file descriptors, leaving it empty
+                inline void take_from( SharedRingMapping &other ) noexcept {
+                    *this = other;
+
+                    other.memory_fd = -1;
+                    other.event_fd  = -1;
+                    other.base      = nullptr;
+                    other.header    = nullptr;
+                }
+
+                inline void unmap() noexcept {
+                    if( this->base != nullptr ) {
+                        munmap( this->base, this->length );
+
+                        this->base   = nullptr;
+                        this->header = nullptr;
+                    }
+
+                    if( this->memory_fd >= 0 ) {
+                        ::close( this->memory_fd );
+
+                        this->memory_fd = -1;
+                    }
+
+                    if( this->event_fd >= 0 ) {
+                        ::close( this->event_fd );
+
+                        this->event_fd = -1;
+                    }
+                }
+        };
+    }
+
+    /*
+     * Consumer end of a shared memory ring buffer, for high rate messaging between processes on the same host.
+     *
+     * Producers in any process reserve space directly in the shared mapping, write their payload, and commit it.
+     * The loop is woken through an eventfd watched by a uv_poll_t, but only when it's actually waiting, so a
+     * steady stream of messages doesn't cost a syscall each. Payloads are handed to the callback in place,
+     * as a Span<const char> into the mapping, and the space is reused once the callback returns.
+     *
+     * A named ring is created with shm_open and can be found by name, while an unnamed one uses memfd_create.
+     * Every descriptor is opened close-on-exec, so only a forked child that doesn't exec keeps them. Anything else gets
+     * the eventfd, and the memfd for an unnamed ring, passed over a unix socket with SCM_RIGHTS.
+     * */
+    class SharedRing final : public Handle<uv_poll_t, SharedRing>,
+                             public detail::SharedRingMapping {
+        public:
+            typedef typename Handle<uv_poll_t, SharedRing>::handle_t handle_t;
+
+        protected:
+            typedef typename Handle<uv_poll_t, SharedRing>::HandleData HandleData;
+
+            std::string name;
+
+            /*
+             * The eventfd can't be closed while the poll handle still has it registered with the loop, and the mapping
+             * can't go while the poll callback might still run, so a ring destroyed without being closed first hands
+             * all of it over to this, to be released from the close callback.
+             * */
+            struct Retired : detail::SharedRingMapping {
+                std::shared_ptr<handle_t> handle;
+                std::string               name;
+
+                inline void release() noexcept {
+                    if( !this->name.empty()) {
+                        shm_unlink( this->name.c_str());
+                    }
+
+                    this->unmap();
+                }
+
+                //On the loop thread
+                static void close( void *p ) {
+                    Retired *r = static_cast<Retired *>(p);
+                    uv_handle_t *h = (uv_handle_t *)r->handle.get();
+
+                    //Unless the poll callback already noticed the handle data had expired and cleaned it up
+                    if( h->data != nullptr ) {
+                        delete static_cast<std::weak_ptr<HandleData> *>(h->data);
+                    }
+
+                    h->data = r;
+
+                    uv_close( h, []( uv_handle_t *closed ) {
+                        Retired *inner = static_cast<Retired *>(closed->data);
+
+                        inner->release();
+
+                        delete inner;
+                    } );
+                }
+            };
+
+            inline void _init() noexcept {
+                //uv_poll_t needs the file descriptor up front, so the first init happens in start
+                if( this->event_fd >= 0 ) {
+                    uv_poll_init( this->loop_handle(), this->handle(), this->event_fd );
+                }
+            }
+
+            inline void _stop() noexcept {
+                uv_poll_stop( this->handle());
+            }
+
+            int create( const std::string &n, size_t capacity ) noexcept {
+                //Capacity has to be a power of two so positions can be masked
+                uint64_t size = 4096;
+
+                while( size < capacity ) {
+                    size <<= 1;
+                }
+
+                size_t len = detail::shared_ring_data_offset() + size;
+                int    fd;
+
+                if( n.empty()) {
+                    fd = memfd_create( "uv++ shared ring", MFD_CLOEXEC );
+
+                } else {
+                    fd = shm_open( n.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+                }
+
+                if( fd < 0 ) {
+                    return -errno;
+                }
+
+                if( ftruncate( fd, (off_t)len ) != 0 ) {
+                    int err = -errno;
+
+                    ::close( fd );
+
+                    return err;
+                }
+
+                int res = this->map( fd, len );
+
+                if( res != 0 ) {
+                    ::close( fd );
+
+                    return res;
+                }
+
+                this->name = n;
+                this->mask = size - 1;
+
+                //Freshly truncated memory is all zero, so only the non-zero parts need setting up
+                this->header->capacity = size;
+                this->header->idle.store( 0, std::memory_order_relaxed );
+                this->header->magic    = detail::SharedRingHeader::MAGIC;
+
+                this->event_fd = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+                return this->event_fd < 0 ? -errno : 0;
+            }
+
+            //Hands every committed record to the callback, returning true if it stopped early with more left
+            template <typename Cont>
+            bool drain( Cont *c, const std::shared_ptr<SharedRing> &self ) {
+                uint64_t pos   = this->header->consumed.load( std::memory_order_relaxed );
+                uint64_t limit = pos + this->mask + 1;
+
+                for( ;; ) {
+                    if( pos >= limit ) {
+                        return true;
+                    }
+
+                    detail::SharedRingRecord *r = this->record_at( pos );
+
+                    if( r->sequence.load( std::memory_order_acquire ) != pos + 1 ) {
+                        return false;
+                    }
+
+                    uint64_t advance;
+
+                    if( r->flags & detail::SharedRingRecord::PADDING ) {
+                        advance = r->size;
+
+                    } else {
+                        advance = detail::shared_ring_record_size( r->size );
+
+                        c->dispatch( self, Span<const char>( reinterpret_cast<const char *>(r + 1), r->size ));
+                    }
+
+                    /*
+                     * Zero the record before giving the space back, so a later record header can never be confused
+                     * with leftover bytes from this lap.
+                     * */
+                    std::memset( static_cast<void *>(r), 0, advance );
+
+                    pos += advance;
+
+                    this->header->consumed.store( pos, std::memory_order_release );
+                }
+            }
+
+            inline bool has_committed() const noexcept {
+                uint64_t pos = this->header->consumed.load( std::memory_order_relaxed );
+
+                return this->record_at( pos )->sequence.load( std::memory_order_seq_cst ) == pos + 1;
+            }
+
+        public:
+            /*
+             * Creates the ring. An empty name creates an anonymous ring with memfd_create.
+             * */
+            template <typename Functor>
+            void start( const std::string &n, size_t capacity, Functor f ) {
+                typedef detail::Continuation<Functor, SharedRing> Cont;
+
+                int res = this->create( n, capacity );
+
+                if( res != 0 ) {
+                    this->unmap();
+
+                    throw ::uv::Exception( res );
+                }
+
+                this->internal_data->continuation = std::make_shared<Cont>( f );
+
+                auto cb = []( uv_poll_t *h, int, int ) {
+                    std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
+
+                    if( d != nullptr ) {
+                        if( auto data = d->lock()) {
+                            if( auto self = data->self.lock()) {
+                                uint64_t count;
+
+                                //Just reset the eventfd counter, the ring itself says what's there
+                                while( ::read( self->event_fd, &count, sizeof( count )) > 0 ) {
+                                }
+
+                                for( ;; ) {
+                                    if( self->drain( data->template cont<Cont>(), self )) {
+                                        //Stopped at the per-wakeup limit, so come back around on the next iteration
+                                        count = 1;
+
+                                        ssize_t r = ::write( self->event_fd, &count, sizeof( count ));
+
+                                        (void)r;
+
+                                        break;
+                                    }
+
+                                    /*
+                                     * Mark the consumer as idle, then look again. Producers commit and then check idle,
+                                     * so with both being sequentially consistent one of the two sides always sees the other.
+                                     * */
+                                    self->header->idle.store( 1, std::memory_order_seq_cst );
+
+                                    if( !self->has_committed()) {
+                                        break;
+                                    }
+
+                                    self->header->idle.store( 0, std::memory_order_relaxed );
+                                }
+                            }
+
+                        } else {
+                            HandleData::cleanup( h, d );
+                        }
+                    }
+                };
+
+                uv_poll_init( this->loop_handle(), this->handle(), this->event_fd );
+
+                //Start out idle, so the first commit wakes the loop
+                this->header->idle.store( 1, std::memory_order_seq_cst );
+
+                uv_poll_start( this->handle(), UV_READABLE, cb );
+
+                this->internal_data->resume = [cb]( SharedRing *self ) {
+                    uv_poll_start( self->handle(), UV_READABLE, cb );
+                };
+            }
+
+            //For passing to producers in other processes with SCM_RIGHTS, or to a forked child
+            inline int eventfd() const noexcept {
+                return this->event_fd;
+            }
+
+            inline int memfd() const noexcept {
+                return this->memory_fd;
+            }
+
+            inline const std::string &shm_name() const noexcept {
+                return this->name;
+            }
+
+            inline size_t capacity() const noexcept {
+                return this->mask + 1;
+            }
+
+            ~SharedRing() {
+                uv_handle_t *h = (uv_handle_t *)this->handle();
+
+                //Once uv_close has been called, the eventfd is no longer watched and the poll callback won't run again
+                if( h->type == UV_POLL && !this->closing && !uv_is_closing( h ) && this->has_loop()) {
+                    Retired *r = new Retired;
+
+                    r->take_from( *this );
+
+                    r->handle = this->_handle;
+                    r->name   = std::move( this->name );
+
+                    //So ~Handle doesn't try to stop what's been handed over
+                    this->closing = true;
+
+                    if( this->on_loop_thread()) {
+                        Retired::close( r );
+
+                    } else {
+                        detail::loop_post( this->loop().get(), r, &Retired::close );
+                    }
+
+                    return;
+                }
+
+                if( !this->name.empty()) {
+                    shm_unlink( this->name.c_str());
+                }
+
+                this->unmap();
+            }
+    };
+
+    /*
+     * Producer end of a SharedRing, usable from any thread of any process that can map the ring.
+     * */
+    class SharedRingWriter : public detail::SharedRingMapping {
+        private:
+            int attach( int fd, int efd ) noexcept {
+                struct stat st;
+
+                //Owned from here on, so unmap closes them whichever way this fails
+                this->memory_fd = fd;
+                this->event_fd  = efd;
+
+                if( fstat( fd, &st ) != 0 ) {
+                    return -errno;
+                }
+
+                if((size_t)st.st_size <= detail::shared_ring_data_offset()) {
+                    return UV_EINVAL;
+                }
+
+                int res = this->map( fd, (size_t)st.st_size );
+
+                if( res != 0 ) {
+                    return res;
+                }
+
+                if( this->header->magic != detail::SharedRingHeader::MAGIC ||
+                    this->header->capacity != st.st_size - detail::shared_ring_data_offset()) {
+                    return UV_EINVAL;
+                }
+
+                this->mask = this->header->capacity - 1;
+
+                return 0;
+            }
+
+            inline void wake() noexcept {
+                if( this->header->idle.load( std::memory_order_seq_cst ) != 0 &&
+                    this->header->idle.exchange( 0, std::memory_order_seq_cst ) != 0 ) {
+                    uint64_t one = 1;
+
+                    ssize_t r = ::write( this->event_fd, &one, sizeof( one ));
+
+                    (void)r;
+                }
+            }
+
+        public:
+            /*
+             * Space reserved in the ring. Write the payload into data(), then commit it.
+             *
+             * Every reservation must be committed, even if it turns out to be unneeded, or the consumer will
+             * wait on it forever.
+             * */
+            class Reservation {
+                    friend class SharedRingWriter;
+
+                    SharedRingWriter         *writer;
+                    detail::SharedRingRecord *record;
+                    uint64_t                 pos;
+
+                    inline Reservation( SharedRingWriter *w, detail::SharedRingRecord *r, uint64_t p ) noexcept
+                        : writer( w ), record( r ), pos( p ) {
+                    }
+
+                public:
+                    inline Reservation() noexcept
+                        : writer( nullptr ), record( nullptr ), pos( 0 ) {
+                    }
+
+                    inline explicit operator bool() const noexcept {
+                        return this->record != nullptr;
+                    }
+
+                    inline char *data() const noexcept {
+                        return reinterpret_cast<char *>(this->record + 1);
+                    }
+
+                    inline size_t size() const noexcept {
+                        return this->record->size;
+                    }
+
+                    inline void commit() noexcept {
+                        assert( this->record != nullptr );
+
+                        this->record->sequence.store( this->pos + 1, std::memory_order_seq_cst );
+
+                        this->writer->wake();
+
+                        this->record = nullptr;
+                    }
+            };
+
+            SharedRingWriter( const SharedRingWriter & ) = delete;
+
+            inline SharedRingWriter() noexcept = default;
+
+            /*
+             * Attaches to a ring by the memfd (or shm fd) and eventfd, both of which the writer takes ownership of.
+             * They're closed if this throws.
+             * */
+            static std::shared_ptr<SharedRingWriter> open( int memory_fd, int event_fd ) {
+                std::shared_ptr<SharedRingWriter> w;
+
+                try {
+                    w = std::make_shared<SharedRingWriter>();
+
+                } catch( ... ) {
+                    ::close( memory_fd );
+                    ::close( event_fd );
+
+                    throw;
+                }
+
+                int res = w->attach( memory_fd, event_fd );
+
+                if( res != 0 ) {
+                    throw ::uv::Exception( res );
+                }
+
+                return w;
+            }
+
+            //Attaches to a named ring, with the eventfd from the consumer, which is owned the same way
+            static std::shared_ptr<SharedRingWriter> open( const std::string &name, int event_fd ) {
+                int fd = shm_open( name.c_str(), O_RDWR, 0 );
+
+                if( fd < 0 ) {
+                    int err = -errno;
+
+                    ::close( event_fd );
+
+                    throw ::uv::Exception( err );
+                }
+
+                return open( fd, event_fd );
+            }
+
+            /*
+             * Reserves space for a payload of the given size. Returns an empty reservation if the ring is full,
+             * which is the producer's signal to back off.
+             * */
+            Reservation reserve( size_t size ) noexcept {
+                uint64_t capacity = this->mask + 1;
+                uint64_t need     = detail::shared_ring_record_size( size );
+
+                //Anything bigger than half the ring could never fit once padding is needed
+                if( need > capacity / 2 ) {
+                    return Reservation();
+                }
+
+                uint64_t pos = this->header->reserved.load( std::memory_order_relaxed );
+
+                for( ;; ) {
+                    uint64_t room  = capacity - ( pos & this->mask );
+                    uint64_t total = need <= room ? need : room + need;
+
+                    if( pos + total - this->header->consumed.load( std::memory_order_acquire ) > capacity ) {
+                        return Reservation();
+                    }
+
+                    if( this->header->reserved.compare_exchange_weak( pos, pos + total, std::memory_order_relaxed )) {
+                        if( total != need ) {
+                            //Records never wrap around, so fill the end of the ring with padding and start over at the front
+                            detail::SharedRingRecord *pad = this->record_at( pos );
+
+                            pad->size  = (uint32_t)room;
+                            pad->flags = detail::SharedRingRecord::PADDING;
+
+                            pad->sequence.store( pos + 1, std::memory_order_seq_cst );
+
+                            pos += room;
+                        }
+
+                        detail::SharedRingRecord *r = this->record_at( pos );
+
+                        r->size  = (uint32_t)size;
+                        r->flags = 0;
+
+                        return Reservation( this, r, pos );
+                    }
+                }
+            }
+
+            //Copies a payload into the ring, returning false if it's full
+            inline bool write( const void *data, size_t size ) noexcept {
+                if( auto r = this->reserve( size )) {
+                    std::memcpy( r.data(), data, size );
+
+                    r.commit();
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            ~SharedRingWriter() {
+                this->unmap();
+            }
+    };
+}
+
+#endif //__linux__
+
+#endif //UV_SHARED_RING_HANDLE_HPP
@@ -31,7 +31,7 @@ namespace uv {
 
                 this->internal_data->continuation = std::make_shared<Cont>( f );
 
-                uv_signal_start( this->handle(), []( uv_signal_t *h, int sn ) {
+                auto cb = []( uv_signal_t *h, int sn ) {
                     std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
 
                     if( d != nullptr ) {
@@ -44,7 +44,13 @@ namespace uv {
                             HandleData::cleanup( h, d );
                         }
                     }
-                }, signum );
+                };
+
+                uv_signal_start( this->handle(), cb, signum );
+
+                this->internal_data->resume = [cb, signum]( Signal *self ) {
+                    uv_signal_start( self->handle(), cb, signum );
+                };
             }
 
             std::string signame() const noexcept {
@@ -23,6 +23,26 @@ namespace uv {
                 uv_timer_stop( this->handle());
             }
 
+            //Milliseconds left until the timer fires, recorded by _suspend for when it is resumed
+            uint64_t _due_in = 0;
+
+            inline void _suspend() noexcept {
+                /*
+                 * uv_timer_t keeps the absolute due time in loop time, which means nothing to another loop,
+                 * so keep the relative time left instead.
+                 * */
+                if( uv_is_active((uv_handle_t *)this->handle())) {
+                    uint64_t now = uv_now( this->handle()->loop );
+
+                    this->_due_in = this->handle()->timeout > now ? this->handle()->timeout - now : 0;
+
+                } else {
+                    this->_due_in = 0;
+                }
+
+                this->_stop();
+            }
+
         public:
             template <typename Functor,
                       typename _Rep, typename _Period,
@@ -39,7 +59,7 @@ namespace uv {
 
                 this->internal_data->continuation = std::make_shared<Cont>( f );
 
-                uv_timer_start( this->handle(), []( uv_timer_t *h ) {
+                auto cb = []( uv_timer_t *h ) {
                     std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
 
                     if( d != nullptr ) {
@@ -52,8 +72,16 @@ namespace uv {
                             HandleData::cleanup( h, d );
                         }
                     }
-                    //libuv expects milliseconds, so convert any duration given to milliseconds
-                }, std::chrono::duration_cast<millis>( timeout ).count(), std::chrono::duration_cast<millis>( repeat ).count());
+                };
+
+                //libuv expects milliseconds, so convert any duration given to milliseconds
+                uint64_t repeat_ms = std::chrono::duration_cast<millis>( repeat ).count();
+
+                uv_timer_start( this->handle(), cb, std::chrono::duration_cast<millis>( timeout ).count(), repeat_ms );
+
+                this->internal_data->resume = [cb, repeat_ms]( Timer *self ) {
+                    uv_timer_start( self->handle(), cb, self->_due_in, repeat_ms );
+                };
             }
     };
 }
@@ -8,11 +8,20 @@
 #include "handle.hpp"
 #include "request.hpp"
 #include "fs.hpp"
+#include "future.hpp"
+#include "cancel.hpp"
+#include "detail/then.hpp"
+#include "detail/coro.hpp"
+#include "detail/fiber.hpp"
 
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <unordered_set>
 #include <unordered_map>
 #include <iomanip>
+#include <algorithm>
+#include <vector>
 
 #ifndef UV_DEFAULT_LOOP_SLEEP
 #define UV_DEFAULT_LOOP_SLEEP 1ms
@@ -29,7 +38,15 @@
 
 #endif
 
+#ifndef UV_FUTURE_POLL_MAX_MS
+# define UV_FUTURE_POLL_MAX_MS 64
+#endif
+
 namespace uv {
+    namespace detail {
+        struct PendingFuture;
+    }
+
     class Loop final : public HandleBase<uv_loop_t, Loop> {
         public:
             typedef typename HandleBase<uv_loop_t, Loop>::handle_t handle_t;
@@ -80,6 +97,53 @@ namespace uv {
 #endif
             std::shared_ptr<Async> schedule_async;
 
+            //Set by whoever wakes the loop up for queued tasks, and cleared once it takes them, so a burst only sends once
+            std::atomic_bool wakeup_pending;
+
+            void wakeup() {
+                if( !this->wakeup_pending.exchange( true )) {
+                    this->schedule_async->send_void_nowait();
+                }
+            }
+
+            //Created the first time a Deadline is made for this loop
+            std::shared_ptr<detail::DeadlineQueue> _deadlines;
+
+            friend class Deadline;
+
+            //Lets Work into the libuv thread-pool by priority
+            detail::WorkGate _work_gate;
+
+            friend detail::WorkGate *detail::loop_work_gate( Loop * );
+
+            detail::RequestMetrics _work_metrics;
+            detail::RequestMetrics _fs_metrics;
+
+            friend detail::RequestMetrics *detail::loop_request_metrics( Loop *, uv_req_type );
+
+            void watch_future( detail::PendingFuture * );
+
+            //Only on the loop thread
+            void add_deadline( std::chrono::steady_clock::time_point, std::weak_ptr<detail::CancelState> );
+
+#ifdef __linux__
+            //Created the first time a fiber is started on this loop
+            std::shared_ptr<detail::FiberHost> _fiber_host;
+
+            inline detail::FiberHost *fiber_host() {
+                if( !this->_fiber_host ) {
+                    this->_fiber_host = std::make_shared<detail::FiberHost>( this );
+                }
+
+                return this->_fiber_host.get();
+            }
+#endif
+
+#ifdef UV_HAS_COROUTINES
+            //Coroutine frames started on this loop's thread are allocated from here
+            detail::FramePool *_frame_pool = new detail::FramePool();
+#endif
+
         protected:
             std::thread::id _loop_thread;
 
@@ -91,19 +155,28 @@ namespace uv {
                 this->schedule_async = this->async( [this] {
                     assert( this->on_loop_thread());
 
+                    /*
+                     * Anything queued after this has to wake the loop up again. It's an exchange rather than a store
+                     * so it synchronizes with the one in wakeup, and every task queued before that is seen below.
+                     * */
+                    this->wakeup_pending.exchange( false );
+
 #ifdef UV_USE_BOOST_LOCKFREE
                     this->task_queue.consume_all( [this]( scheduled_task &task ) {
                         task.second( task.first );
                     } );
 #else
+                    std::deque<scheduled_task> tasks;
+
                     {
+                        //Take everything queued so far, so tasks can schedule more tasks without deadlocking
                         std::lock_guard<std::mutex> lock( this->schedule_mutex );
 
-                        for( scheduled_task &task : this->task_queue ) {
-                            task.second( task.first );
-                        }
+                        tasks.swap( this->task_queue );
+                    }
 
-                        this->task_queue.clear();
+                    for( scheduled_task &task : tasks ) {
+                        task.second( task.first );
                     }
 #endif
                     this->update_time();
@@ -129,7 +202,8 @@ namespace uv {
 
         private:
             explicit inline Loop()
-                : _loop_thread( std::this_thread::get_id())
+                : wakeup_pending( false ),
+                  _loop_thread( std::this_thread::get_id())
 #ifdef UV_USE_BOOST_LOCKFREE
                 , task_queue( UV_LOCKFREE_QUEUE_SIZE )
 #endif
@@ -175,6 +249,10 @@ namespace uv {
 
                 this->has_ran = true;
 
+#ifdef UV_HAS_COROUTINES
+                detail::FramePool::CurrentScope frames( this->_frame_pool );
+#endif
+
                 return uv_run( this->handle(), (uv_run_mode)( mode ));
             }
 
@@ -243,6 +321,16 @@ namespace uv {
                 return *this;
             }
 
+            template <typename... Args>
+            typename std::enable_if<detail::all_type<uv_loop_option, Args...>::value, Loop &>::type
+            configure( std::error_code &ec, Args &&... args ) noexcept {
+                assert( this->on_loop_thread());
+
+                detail::set_error( ec, uv_loop_configure( this->handle(), std::forward<Args>( args )... ));
+
+                return *this;
+            }
+
             inline static size_t size() noexcept {
                 return uv_loop_size();
             }
@@ -289,6 +377,17 @@ namespace uv {
                 return ( res == 0 );
             }
 
+            //returns true on closed, sets ec otherwise
+            inline bool close( std::error_code &ec ) noexcept {
+                int res;
+
+                bool closed = this->try_close( &res );
+
+                detail::set_error( ec, res );
+
+                return closed;
+            }
+
             //returns true on closed, throws otherwise
             inline bool close() {
                 int res;
@@ -305,6 +404,56 @@ namespace uv {
                     this->stop();
                     delete handle();
                 }
+
+#ifdef UV_HAS_COROUTINES
+                this->_frame_pool->release();
+#endif
+            }
+
+        private:
+            /*
+             * Removes a handle from whichever set it's tracked in, returning the handle and whether it was weak.
+             * */
+            std::shared_ptr<void> release_handle( void *p, bool *weak ) {
+                std::lock_guard<std::mutex> lock( this->handle_mutex );
+
+                auto wit = this->weak_handles.find( p );
+
+                if( wit != this->weak_handles.end()) {
+                    auto h = wit->second.lock();
+
+                    this->weak_handles.erase( wit );
+
+                    *weak = true;
+
+                    return h;
+                }
+
+                //Aliasing constructor with an empty owner, just to have something to look up by pointer
+                auto it = this->handles.find( std::shared_ptr<void>( std::shared_ptr<void>(), p ));
+
+                *weak = false;
+
+                if( it != this->handles.end()) {
+                    auto h = *it;
+
+                    this->handles.erase( it );
+
+                    return h;
+                }
+
+                return nullptr;
+            }
+
+            void adopt_handle( std::shared_ptr<void> h, bool weak ) {
+                std::lock_guard<std::mutex> lock( this->handle_mutex );
+
+                if( weak ) {
+                    this->weak_handles.emplace( weak_handle_map::value_type{ h.get(), std::weak_ptr<void>( h ) } );
+
+                } else {
+                    this->handles.insert( std::move( h ));
+                }
             }
 
         protected:
@@ -437,16 +586,178 @@ namespace uv {
                 return new_handle<AsyncDetail<Functor>>( true, weak, f );
             }
 
+            /*
+             * Creates a channel that any thread can push values of type T into. The callback receives
+             * every value pushed since the last wakeup as a single Span<T>.
+             * */
+            template <typename T, typename Functor>
+            inline std::shared_ptr<Channel<T>> channel( Functor f, size_t capacity = UV_CHANNEL_CAPACITY ) {
+                return new_handle<Channel<T>>( true, false, f, capacity );
+            }
+
+            /*
+             * Creates a batcher that flushes items of type T to the callback after max_items, max_bytes,
+             * or max_delay after the first item of a batch, whichever comes first.
+             * */
+            template <typename T, typename Functor, typename _Rep, typename _Period>
+            inline std::shared_ptr<Batcher<T>> batcher( Functor f, size_t max_items, size_t max_bytes,
+                                                        const std::chrono::duration<_Rep, _Period> &max_delay ) {
+                return new_handle<Batcher<T>>( true, false, f, max_items, max_bytes, max_delay );
+            }
+
+#ifdef __linux__
+            /*
+             * Creates a shared memory ring buffer that producers in other processes can write into with SharedRingWriter.
+             * An empty name makes an anonymous ring, which has to be shared by its memfd.
+             * */
+            template <typename Functor>
+            inline std::shared_ptr<SharedRing> shared_ring( const std::string &name, size_t capacity, Functor f ) {
+                return new_handle<SharedRing>( true, false, name, capacity, f );
+            }
+#endif
+
             template <typename Functor>
             inline std::shared_ptr<Signal> signal( int signal, Functor f ) {
                 return new_handle<Signal>( true, false, signal, f );
             }
 
+            /*
+             * Runs fn( arg ) on the loop thread, without any result or promise. This is the cheapest way onto the loop,
+             * and doesn't allocate when used with the boost lockfree queue.
+             * */
+            void post( void *arg, void (*fn)( void * )) {
+                scheduled_task t{ arg, fn };
+
+#ifdef UV_USE_BOOST_LOCKFREE
+                this->task_queue.push( t );
+#else
+                {
+                    std::lock_guard<std::mutex> lock( this->schedule_mutex );
+
+                    this->task_queue.push_back( t );
+                }
+#endif
+                this->wakeup();
+            }
+
+            //Like schedule, but for when nobody needs the result
+            template <typename Functor>
+            void post( Functor &&f ) {
+                typedef typename std::decay<Functor>::type F;
+
+                this->post( new F( std::forward<Functor>( f )), []( void *p ) {
+                    std::unique_ptr<F> fp( static_cast<F *>(p));
+
+                    ( *fp )();
+                } );
+            }
+
+            /*
+             * Turns a std::future into a uv::Future that is completed on this loop thread, without blocking the loop.
+             * Pending futures from every loop are polled by one shared helper thread that backs off while nothing is
+             * completing, up to UV_FUTURE_POLL_MAX_MS between polls, and hands them back to each loop in batches.
+             *
+             * Deferred futures, like from std::async( std::launch::deferred, ... ), are handed back right away, and
+             * their function runs on this loop thread.
+             * */
+            template <typename T>
+            Future<T> poll_future( std::future<T> f );
+
+            template <typename T>
+            Future<T> poll_future( std::shared_future<T> f );
+
+            /*
+             * Like poll_future, but calls cb( std::future<T> ) on this loop thread once the future is ready, for
+             * futures from other libraries that don't need to be chained. get() on it won't block by then.
+             * */
+            template <typename T, typename Functor>
+            void when_ready( std::future<T> f, Functor &&cb );
+
+            template <typename T, typename Functor>
+            void when_ready( std::shared_future<T> f, Functor &&cb );
+
+#ifdef __linux__
+            /*
+             * Runs the functor in a stackful fiber on this loop, where it can call fiber_await and the other fiber_*
+             * functions from fiber.hpp to wait on things without blocking the loop. Returns a future for its result.
+             *
+             * On the loop thread, the fiber runs right away until it first waits on something.
+             * */
+            template <typename Functor>
+            Future<decltype( std::declval<Functor &>()())> fiber( Functor f ) {
+                typedef decltype( std::declval<Functor &>()()) R;
+
+                typedef detail::FiberTask<Functor, R> Task;
+
+                auto *t = new Task( std::move( f ));
+
+                Future<R> ret = t->promise.get_future();
+
+                //Failing to start, like running out of memory for a stack, means it never ran and nothing else has it
+                auto start = []( Loop *l, Task *task ) {
+                    try {
+                        l->fiber_host()->start( task );
+
+                    } catch( ... ) {
+                        task->promise.set_exception( std::current_exception());
+
+                        delete task;
+                    }
+                };
+
+                if( this->on_loop_thread()) {
+                    start( this, t );
+
+                } else {
+                    auto self = this->shared_from_this();
+
+                    this->post( [self, t, start] {
+                        start( self.get(), t );
+                    } );
+                }
+
+                return ret;
+            }
+#endif
+
+#ifdef UV_HAS_COROUTINES
+            /*
+             * co_await loop->schedule() carries on on the loop thread, straight away if it's there already.
+             * */
+            inline detail::ScheduleAwaiter schedule() noexcept {
+                return detail::ScheduleAwaiter{ this };
+            }
+
+            //co_await loop->sleep( 10ms ) resumes on the loop thread once the time is up
+            template <typename _Rep, typename _Period>
+            inline detail::SleepAwaiter sleep( const std::chrono::duration<_Rep, _Period> &timeout ) noexcept {
+                typedef std::chrono::duration<uint64_t, std::milli> millis;
+
+                return detail::SleepAwaiter( this, std::chrono::duration_cast<millis>( timeout ).count());
+            }
+
+            /*
+             * co_await loop->queue_work( f, args... ) runs the functor on the thread-pool and resumes on the loop thread
+             * with its result, or throws whatever it threw. It goes straight to libuv, skipping the Work priority classes.
+             * */
             template <typename Functor, typename... Args>
-            UV_DECLTYPE_AUTO schedule( Functor f, Args... args ) {
-                typedef detail::AsyncContinuation<Functor, Loop> Cont;
+            inline detail::WorkAwaiter<typename std::decay<Functor>::type, typename std::decay<Args>::type...>
+            queue_work( Functor &&f, Args &&... args ) {
+                return detail::WorkAwaiter<typename std::decay<Functor>::type, typename std::decay<Args>::type...>(
+                    this, std::forward<Functor>( f ), std::forward<Args>( args )... );
+            }
+#endif
+
+            /*
+             * Both the functor and its arguments are forwarded along, so rvalues are moved all the way through
+             * to the loop thread and move-only types can be scheduled.
+             * */
+            template <typename Functor, typename... Args,
+                      typename = typename std::enable_if<!std::is_base_of<CancellationToken, typename std::decay<Functor>::type>::value>::type>
+            UV_DECLTYPE_AUTO schedule( Functor &&f, Args &&... args ) {
+                typedef detail::AsyncContinuation<typename std::decay<Functor>::type, Loop> Cont;
 
-                Cont *c = new Cont( f );
+                Cont *c = new Cont( std::forward<Functor>( f ));
 
                 auto ret = c->init( this->shared_from_this(), std::forward<Args>( args )... );
 
@@ -468,16 +779,132 @@ namespace uv {
                     this->task_queue.push_back( t );
                 }
 #endif
-                this->schedule_async->send_void();
+                //Nobody needs the result of the wakeup itself, so don't bother creating a promise for it
+                this->wakeup();
+
+                return ret;
+            }
+
+            /*
+             * Like schedule, but the task is dropped if the token is cancelled before it gets to run, and the future
+             * fails right away with the token's reason instead of waiting for the loop to get around to it.
+             * */
+            template <typename Functor, typename... Args>
+            std::shared_future<detail::fn_result_of<typename std::decay<Functor>::type>>
+            schedule( const CancellationToken &token, Functor &&f, Args &&... args ) {
+                typedef typename std::decay<Functor>::type            F;
+                typedef detail::fn_result_of<F>                       R;
+                typedef std::tuple<typename std::decay<Args>::type...> Tuple;
+
+                struct Task {
+                    std::atomic_bool  claimed;
+                    std::promise<R>   promise;
+                    CancellationToken token;
+                    uint64_t          subscription = 0;
+                    F                 f;
+                    Tuple             args;
+
+                    inline Task( const CancellationToken &t, F &&fn, Tuple &&a )
+                        : claimed( false ), token( t ), f( std::move( fn )), args( std::move( a )) {
+                    }
+
+                    //Either the task runs or it's cancelled, never both
+                    inline bool claim() noexcept {
+                        return !this->claimed.exchange( true, std::memory_order_acq_rel );
+                    }
+                };
+
+                auto t = std::make_shared<Task>( token, F( std::forward<Functor>( f )), Tuple( std::forward<Args>( args )... ));
+
+                std::shared_future<R> ret = t->promise.get_future().share();
+
+                std::weak_ptr<Task> weak = t;
+
+                t->subscription = token.subscribe( [weak]( int reason ) {
+                    if( auto st = weak.lock()) {
+                        if( st->claim()) {
+                            st->promise.set_exception( std::make_exception_ptr( ::uv::Exception( reason )));
+                        }
+                    }
+                } );
+
+                if( !t->claimed.load( std::memory_order_acquire )) {
+                    this->post( [t] {
+                        if( t->claim()) {
+                            t->token.unsubscribe( t->subscription );
+
+                            detail::dispatch_helper<R>::dispatch( t->promise, t->f, t->args );
+                        }
+                    } );
+                }
 
                 return ret;
             }
 
+            /*
+             * Moves a started handle from this loop over to the target loop, keeping its continuation and user data.
+             *
+             * The libuv side is stopped and closed on this loop's thread, then initialized and started again on the
+             * target loop's thread. The returned future resolves once the handle is running on the target loop.
+             * */
+            template <typename D>
+            inline std::shared_future<void> migrate( std::shared_ptr<D> h, std::shared_ptr<Loop> target ) {
+                assert( h->loop().get() == this );
+
+                if( target.get() == this ) {
+                    return detail::make_ready_future();
+                }
+
+                return h->migrate( target );
+            }
+
             inline std::shared_ptr<Work> work( bool weak = false ) {
                 //Work is special since it doesn't initialize on the loop thread
                 return new_handle<Work>( false, weak );
             };
 
+            inline std::shared_ptr<Work> work( WorkPriority priority, bool weak = false ) {
+                std::shared_ptr<Work> w = this->work( weak );
+
+                w->set_priority( priority );
+
+                return w;
+            }
+
+            //Work that runs on the given pool rather than the libuv thread-pool
+            inline std::shared_ptr<Work> work( std::shared_ptr<ThreadPool> pool, bool weak = false ) {
+                std::shared_ptr<Work> w = this->work( weak );
+
+                w->set_pool( std::move( pool ));
+
+                return w;
+            }
+
+            /*
+             * How much Work of the given priority has gone through this loop, and how long it waited for a thread.
+             * Only Work is counted, not other things queued onto the thread-pool.
+             * */
+            inline WorkClassStats work_stats( WorkPriority priority ) const noexcept {
+                return this->_work_gate.stats( priority );
+            }
+
+            /*
+             * Queue wait, run time and latency histograms, along with how many were in flight, for Work (UV_WORK) and
+             * FSRequest (UV_FS) requests made on this loop. Anything else comes back empty. Safe from any thread.
+             * */
+            inline RequestStats request_stats( uv_req_type type ) const noexcept {
+                switch( type ) {
+                    case UV_WORK:
+                        return this->_work_metrics.snapshot();
+
+                    case UV_FS:
+                        return this->_fs_metrics.snapshot();
+
+                    default:
+                        return detail::RequestMetrics().snapshot();
+                }
+            }
+
             /*
              * This is such a mess, but that's what I get for mixing C and C++
              *
@@ -559,6 +986,35 @@ namespace uv {
             return this->loop_thread() == std::this_thread::get_id();
         }
 
+        inline bool loop_on_thread( Loop *l ) {
+            return l->on_loop_thread();
+        }
+
+        inline uv_loop_t *loop_handle( Loop *l ) {
+            return l->handle();
+        }
+
+        inline void loop_post( Loop *l, void *arg, void (*fn)( void * )) {
+            l->post( arg, fn );
+        }
+
+        inline WorkGate *loop_work_gate( Loop *l ) {
+            return &l->_work_gate;
+        }
+
+        inline RequestMetrics *loop_request_metrics( Loop *l, uv_req_type type ) {
+            switch( type ) {
+                case UV_WORK:
+                    return &l->_work_metrics;
+
+                case UV_FS:
+                    return &l->_fs_metrics;
+
+                default:
+                    return nullptr;
+            }
+        }
+
         struct DefaultLoop : LazyStatic<std::shared_ptr<Loop>> {
             std::shared_ptr<Loop> init() {
                 return Loop::make_loop( uv_default_loop());
@@ -568,6 +1024,443 @@ namespace uv {
         static DefaultLoop default_loop;
     }
 
+    inline void LoopExecutor::execute( void (*fn)( void * ), void *arg ) const {
+        this->loop->post( arg, fn );
+    }
+
+    namespace detail {
+        /*
+         * A deferred future never becomes ready on its own, and only runs once someone calls get() on it, so it counts
+         * as settled straight away and runs on the loop thread when it's delivered.
+         * */
+        template <typename F>
+        inline bool future_settled( const F &f ) {
+            return f.wait_for( std::chrono::seconds( 0 )) != std::future_status::timeout;
+        }
+
+        struct PendingFuture {
+            //Called on the bridge thread, and has to be cheap
+            virtual bool ready() = 0;
+
+            //Called on the loop thread once ready() returned true
+            virtual void deliver() noexcept = 0;
+
+            virtual ~PendingFuture() = default;
+        };
+
+        template <typename F, typename T>
+        struct PendingStdFuture final : PendingFuture {
+            F          future;
+            Promise<T> result;
+
+            inline explicit PendingStdFuture( F &&f )
+                : future( std::move( f )) {
+            }
+
+            template <typename U = T>
+            inline typename std::enable_if<!std::is_void<U>::value>::type forward() {
+                this->result.set_value( this->future.get());
+            }
+
+            template <typename U = T>
+            inline typename std::enable_if<std::is_void<U>::value>::type forward() {
+                this->future.get();
+
+                this->result.set_value();
+            }
+
+            bool ready() override {
+                return future_settled( this->future );
+            }
+
+            void deliver() noexcept override {
+                try {
+                    this->forward();
+
+                } catch( ... ) {
+                    this->result.set_exception( std::current_exception());
+                }
+            }
+        };
+
+        //Hands the ready future itself to a callback, so nothing has to be allocated for the result
+        template <typename F, typename Functor>
+        struct PendingCallback final : PendingFuture {
+            F       future;
+            Functor f;
+
+            inline PendingCallback( F &&fut, Functor &&fn )
+                : future( std::move( fut )), f( std::move( fn )) {
+            }
+
+            bool ready() override {
+                return future_settled( this->future );
+            }
+
+            //Like any other task on the loop, there's nowhere for an exception to go
+            void deliver() noexcept override {
+                try {
+                    this->f( std::move( this->future ));
+
+                } catch( ... ) {
+                }
+            }
+        };
+
+        /*
+         * Watches std::futures for every loop in the process from a single helper thread, since they have no way of
+         * notifying anything, and polling thousands of them shouldn't cost the loops themselves anything.
+         *
+         * The thread sleeps until there's something to watch, then polls everything with wait_for( 0 ), starting out
+         * at a millisecond apart and doubling every time nothing is ready, up to UV_FUTURE_POLL_MAX_MS, and dropping
+         * back down as soon as something completes or a new future comes in. Whatever is ready in a round is handed
+         * to each loop in a single batch, as one task on its queue.
+         * */
+        class FutureBridge {
+            protected:
+                typedef std::pair<std::weak_ptr<Loop>, PendingFuture *> entry;
+
+                std::mutex              mutex;
+                std::condition_variable cv;
+                std::vector<entry>      incoming;
+                bool                    stopping = false;
+
+                std::thread thread;
+
+                struct Batch {
+                    std::weak_ptr<Loop>         loop;
+                    std::vector<PendingFuture *> ready;
+                };
+
+                static void deliver( void *p ) {
+                    std::unique_ptr<Batch> b( static_cast<Batch *>(p));
+
+                    for( PendingFuture *f : b->ready ) {
+                        f->deliver();
+
+                        delete f;
+                    }
+                }
+
+                //Posts each loop's batch, dropping the futures of loops that are gone
+                static void flush( std::vector<Batch> &batches ) {
+                    for( Batch &b : batches ) {
+                        if( auto l = b.loop.lock()) {
+                            l->post( new Batch( std::move( b )), &FutureBridge::deliver );
+
+                        } else {
+                            for( PendingFuture *f : b.ready ) {
+                                delete f;
+                            }
+                        }
+                    }
+
+                    batches.clear();
+                }
+
+                static void collect( std::vector<Batch> &batches, entry &e ) {
+                    for( Batch &b : batches ) {
+                        if( !b.loop.owner_before( e.first ) && !e.first.owner_before( b.loop )) {
+                            b.ready.push_back( e.second );
+
+                            return;
+                        }
+                    }
+
+                    batches.push_back( Batch{ e.first, { e.second }} );
+                }
+
+                void run() {
+                    std::vector<entry> pending;
+                    std::vector<Batch> batches;
+
+                    uint64_t interval = 1;
+
+                    std::unique_lock<std::mutex> lock( this->mutex );
+
+                    while( true ) {
+                        if( pending.empty() && this->incoming.empty()) {
+                            this->cv.wait( lock, [this] {
+                                return this->stopping || !this->incoming.empty();
+                            } );
+
+                        } else if( this->incoming.empty()) {
+                            this->cv.wait_for( lock, std::chrono::milliseconds( interval ), [this] {
+                                return this->stopping || !this->incoming.empty();
+                            } );
+                        }
+
+                        if( this->stopping ) {
+                            break;
+                        }
+
+                        bool fresh = !this->incoming.empty();
+
+                        pending.insert( pending.end(), this->incoming.begin(), this->incoming.end());
+
+                        this->incoming.clear();
+
+                        lock.unlock();
+
+                        size_t before = pending.size();
+
+                        pending.erase( std::remove_if( pending.begin(), pending.end(), [&batches]( entry &e ) {
+                            if( e.second->ready()) {
+                                collect( batches, e );
+
+                                return true;
+                            }
+
+                            return false;
+                        } ), pending.end());
+
+                        if( fresh || pending.size() < before ) {
+                            interval = 1;
+
+                        } else if( interval < UV_FUTURE_POLL_MAX_MS ) {
+                            interval <<= 1;
+                        }
+
+                        flush( batches );
+
+                        lock.lock();
+                    }
+                }
+
+            public:
+                static FutureBridge &instance() {
+                    static FutureBridge bridge;
+
+                    return bridge;
+                }
+
+                //From any thread
+                void add( std::weak_ptr<Loop> l, PendingFuture *p ) {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    if( !this->thread.joinable()) {
+                        this->thread = std::thread( [this] {
+                            this->run();
+                        } );
+                    }
+
+                    this->incoming.emplace_back( std::move( l ), p );
+
+                    this->cv.notify_one();
+                }
+
+                /*
+                 * Only at exit. Whatever is still pending is left alone rather than failed, since that would run
+                 * continuations on loops that may already be gone.
+                 * */
+                ~FutureBridge() {
+                    {
+                        std::lock_guard<std::mutex> lock( this->mutex );
+
+                        this->stopping = true;
+
+                        this->cv.notify_one();
+                    }
+
+                    if( this->thread.joinable()) {
+                        this->thread.join();
+                    }
+                }
+        };
+    }
+
+    inline void Loop::watch_future( detail::PendingFuture *p ) {
+        detail::FutureBridge::instance().add( this->shared_from_this(), p );
+    }
+
+    template <typename T>
+    Future<T> Loop::poll_future( std::future<T> f ) {
+        auto *p = new detail::PendingStdFuture<std::future<T>, T>( std::move( f ));
+
+        Future<T> ret = p->result.get_future();
+
+        this->watch_future( p );
+
+        return ret;
+    }
+
+    template <typename T>
+    Future<T> Loop::poll_future( std::shared_future<T> f ) {
+        auto *p = new detail::PendingStdFuture<std::shared_future<T>, T>( std::move( f ));
+
+        Future<T> ret = p->result.get_future();
+
+        this->watch_future( p );
+
+        return ret;
+    }
+
+    template <typename T, typename Functor>
+    void Loop::when_ready( std::future<T> f, Functor &&cb ) {
+        this->watch_future( new detail::PendingCallback<std::future<T>, typename std::decay<Functor>::type>( std::move( f ), std::forward<Functor>( cb )));
+    }
+
+    template <typename T, typename Functor>
+    void Loop::when_ready( std::shared_future<T> f, Functor &&cb ) {
+        this->watch_future( new detail::PendingCallback<std::shared_future<T>, typename std::decay<Functor>::type>( std::move( f ), std::forward<Functor>( cb )));
+    }
+
+    namespace detail {
+        /*
+         * Every Deadline on a loop goes into one min-heap, with a single timer armed for the earliest expiry.
+         *
+         * Deadlines that are cancelled early, or whose tokens are gone, aren't searched for. They're popped whenever
+         * they reach the top, and swept out all at once if the heap doubles in size since the last sweep, so it never
+         * holds many more than the live ones.
+         *
+         * The timer is unreferenced, so pending deadlines alone don't keep the loop running.
+         * */
+        class DeadlineQueue {
+            protected:
+                typedef std::chrono::steady_clock::time_point time_point;
+
+                typedef std::pair<time_point, std::weak_ptr<CancelState>> entry;
+
+                struct later {
+                    inline bool operator()( const entry &a, const entry &b ) const noexcept {
+                        return a.first > b.first;
+                    }
+                };
+
+                std::shared_ptr<Timer> timer;
+                std::vector<entry>     heap;
+                time_point             armed    = time_point::max();
+                size_t                 sweep_at = 64;
+
+                static inline bool dead( const entry &e ) noexcept {
+                    auto s = e.second.lock();
+
+                    return !s || s->get() != 0;
+                }
+
+                void prune() {
+                    if( this->heap.size() >= this->sweep_at ) {
+                        this->heap.erase( std::remove_if( this->heap.begin(), this->heap.end(), &DeadlineQueue::dead ), this->heap.end());
+
+                        std::make_heap( this->heap.begin(), this->heap.end(), later());
+
+                        this->sweep_at = std::max<size_t>( 64, this->heap.size() * 2 );
+                    }
+
+                    while( !this->heap.empty() && dead( this->heap.front())) {
+                        std::pop_heap( this->heap.begin(), this->heap.end(), later());
+
+                        this->heap.pop_back();
+                    }
+                }
+
+                //Rounded up, so the timer never fires before the earliest deadline is actually up
+                static inline uint64_t millis_until( time_point t ) noexcept {
+                    auto now = std::chrono::steady_clock::now();
+
+                    if( t <= now ) {
+                        return 0;
+                    }
+
+                    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>( t - now + std::chrono::milliseconds( 1 ) - std::chrono::nanoseconds( 1 )).count();
+                }
+
+                void arm( Loop *l ) {
+                    this->prune();
+
+                    if( this->heap.empty()) {
+                        this->armed = time_point::max();
+
+                        if( this->timer ) {
+                            this->timer->stop();
+                        }
+
+                        return;
+                    }
+
+                    time_point next = this->heap.front().first;
+
+                    if( next == this->armed ) {
+                        return;
+                    }
+
+                    this->armed = next;
+
+                    //uv_timer_again restarts the timer with the repeat as its timeout, and fire() takes care of the rest
+                    uint64_t ms = std::max<uint64_t>( millis_until( next ), 1 );
+
+                    if( !this->timer ) {
+                        this->timer = l->timer( [this, l] {
+                            this->fire( l );
+                        }, std::chrono::milliseconds( ms ), std::chrono::milliseconds( ms ));
+
+                        uv_unref((uv_handle_t *)this->timer->handle());
+
+                    } else {
+                        uv_timer_set_repeat( this->timer->handle(), ms );
+
+                        uv_timer_again( this->timer->handle());
+                    }
+                }
+
+                void fire( Loop *l ) {
+                    auto now = std::chrono::steady_clock::now();
+
+                    //Collect first, since cancelling runs callbacks that might add more deadlines
+                    std::vector<std::shared_ptr<CancelState>> expired;
+
+                    while( !this->heap.empty() && this->heap.front().first <= now ) {
+                        std::pop_heap( this->heap.begin(), this->heap.end(), later());
+
+                        if( auto s = this->heap.back().second.lock()) {
+                            expired.push_back( std::move( s ));
+                        }
+
+                        this->heap.pop_back();
+                    }
+
+                    this->armed = time_point::max();
+
+                    this->arm( l );
+
+                    for( auto &s : expired ) {
+                        s->cancel( UV_ETIMEDOUT );
+                    }
+                }
+
+            public:
+                void add( Loop *l, time_point t, std::weak_ptr<CancelState> s ) {
+                    this->heap.emplace_back( t, std::move( s ));
+
+                    std::push_heap( this->heap.begin(), this->heap.end(), later());
+
+                    this->arm( l );
+                }
+        };
+    }
+
+    inline void Loop::add_deadline( std::chrono::steady_clock::time_point t, std::weak_ptr<detail::CancelState> s ) {
+        if( !this->_deadlines ) {
+            this->_deadlines = std::make_shared<detail::DeadlineQueue>();
+        }
+
+        this->_deadlines->add( this, t, std::move( s ));
+    }
+
+    inline Deadline::Deadline( std::shared_ptr<Loop> l, time_point t )
+        : CancellationToken( std::make_shared<detail::CancelState>()), when( t ) {
+        std::weak_ptr<detail::CancelState> weak = this->state;
+
+        if( l->on_loop_thread()) {
+            l->add_deadline( t, std::move( weak ));
+
+        } else {
+            l->post( [l, t, weak] {
+                l->add_deadline( t, weak );
+            } );
+        }
+    }
+
     inline std::shared_ptr<Loop> default_loop() {
         return detail::default_loop;
     }
@@ -615,10 +1508,139 @@ namespace uv {
             };
 
             if( this->on_loop_thread()) {
+                this->wait_for_senders();
+
+                this->_closing();
+
                 uv_close((uv_handle_t *)this->handle(), cb );
 
             } else {
                 this->loop()->schedule( [this, cb] {
+                    this->wait_for_senders();
+
+                    this->_closing();
+
+                    uv_close((uv_handle_t *)this->handle(), cb );
+                } );
+            }
+
+            return ret;
+        }
+    }
+
+    namespace detail {
+        template <typename D>
+        struct MigrateContinuation {
+            std::shared_ptr<D>    self;
+            std::shared_ptr<Loop> source, target;
+            std::promise<void>    result;
+
+            //Whether the handle was running before it was suspended, since only those are started back up
+            bool was_active = false;
+        };
+    }
+
+    template <typename H, typename D>
+    std::shared_future<void> Handle<H, D>::migrate( std::shared_ptr<Loop> target ) {
+        typedef detail::MigrateContinuation<D> Cont;
+
+        assert( bool( target ));
+
+        //Handles that were never started, or that can't be safely brought back up (like Async), can't be moved
+        if( !this->internal_data->resume ) {
+            return detail::make_exception_future<void>( ::uv::Exception( UV_ENOTSUP ));
+        }
+
+        /*
+         * Same as with close, but the handle is only marked as closing while it's in between loops,
+         * so nothing else can close or migrate it in the meantime.
+         * */
+
+        bool expect_closing = false;
+
+        this->closing.compare_exchange_strong( expect_closing, true );
+
+        if( expect_closing ) {
+            return detail::make_exception_future<void>( ::uv::Exception( "handle already closing or closed" ));
+
+        } else {
+            auto c = std::make_shared<Cont>();
+
+            c->self   = std::static_pointer_cast<D>( this->shared_from_this());
+            c->source = this->loop();
+            c->target = target;
+
+            std::shared_future<void> ret = c->result.get_future();
+
+            this->internal_data->close_continuation = c;
+
+            auto cb = []( uv_handle_t *h ) {
+                std::weak_ptr<HandleData> *d = static_cast<std::weak_ptr<HandleData> *>(h->data);
+
+                if( d != nullptr ) {
+                    if( auto data = d->lock()) {
+                        auto mc = std::static_pointer_cast<Cont>( data->close_continuation );
+
+                        data->close_continuation.reset();
+
+                        //The libuv side is closed now, so bring it back up on the target loop thread
+                        mc->target->schedule( [mc] {
+                            Handle *self = mc->self.get();
+
+                            std::exception_ptr error;
+
+                            /*
+                             * Stopped handles, and one-shot timers that already fired, stay that way. If starting it
+                             * back up fails, the handle still ends up on the target loop, just not running.
+                             * */
+                            try {
+                                self->_loop_init( mc->target );
+
+                                self->_init();
+
+                                if( mc->was_active ) {
+                                    self->internal_data->resume( mc->self.get());
+                                }
+
+                            } catch( ... ) {
+                                error = std::current_exception();
+                            }
+
+                            bool weak;
+
+                            if( auto owned = mc->source->release_handle( mc->self.get(), &weak )) {
+                                mc->target->adopt_handle( owned, weak );
+                            }
+
+                            self->closing = false;
+
+                            if( error ) {
+                                mc->result.set_exception( error );
+
+                            } else {
+                                mc->result.set_value();
+                            }
+                        } );
+
+                    } else {
+                        HandleData::cleanup( reinterpret_cast<H *>( h ), d );
+                    }
+                }
+            };
+
+            if( this->on_loop_thread()) {
+                c->was_active = uv_is_active((uv_handle_t *)this->handle()) != 0;
+
+                this->_suspend();
+
+                uv_close((uv_handle_t *)this->handle(), cb );
+
+            } else {
+                this->loop()->schedule( [this, c, cb] {
+                    c->was_active = uv_is_active((uv_handle_t *)this->handle()) != 0;
+
+                    this->_suspend();
+
                     uv_close((uv_handle_t *)this->handle(), cb );
                 } );
             }
@@ -628,7 +1650,7 @@ namespace uv {
     }
 
     template <typename... Args>
-    inline UV_DECLTYPE_AUTO schedule( std::shared_ptr<Loop> l, Args... args ) {
+    inline UV_DECLTYPE_AUTO schedule( std::shared_ptr<Loop> l, Args &&... args ) {
         return l->schedule( std::forward<Args>( args )... );
     }
 }
@@ -0,0 +1,225 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_METRICS_HPP
+#define UV_METRICS_HPP
+
+#include "defines.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace uv {
+    /*
+     * A snapshot of a histogram with power of two buckets, where bucket zero counts zeroes and bucket i counts values
+     * from 2^(i-1) up to but not including 2^i. Durations are in nanoseconds.
+     * */
+    struct Histogram {
+        enum : size_t {
+            BUCKETS = 65
+        };
+
+        uint64_t count;
+        uint64_t sum;
+        uint64_t max;
+
+        uint64_t buckets[BUCKETS];
+
+        inline uint64_t mean() const noexcept {
+            return this->count == 0 ? 0 : this->sum / this->count;
+        }
+
+        //An upper bound on the given percentile, from 0 to 100, accurate to within a factor of two
+        uint64_t percentile( double p ) const noexcept {
+            if( this->count == 0 ) {
+                return 0;
+            }
+
+            uint64_t rank = (uint64_t)( p / 100.0 * (double)this->count );
+            uint64_t seen = 0;
+
+            for( size_t i = 0; i < BUCKETS; ++i ) {
+                seen += this->buckets[i];
+
+                if( seen > rank ) {
+                    uint64_t bound = i == 0 ? 0 : i == 64 ? UINT64_MAX : ( uint64_t( 1 ) << i ) - 1;
+
+                    return bound < this->max ? bound : this->max;
+                }
+            }
+
+            return this->max;
+        }
+    };
+
+    //From Loop::request_stats, for one kind of request on one loop
+    struct RequestStats {
+        //From being queued to a thread starting it. Filesystem requests don't say when they start, so only have latency.
+        Histogram queue_wait;
+
+        //Running on the thread
+        Histogram run;
+
+        //From being queued to its callback on the loop thread, like after_work_cb
+        Histogram latency;
+
+        //How many were in flight each time one was queued, including that one
+        Histogram in_flight;
+
+        uint64_t in_flight_now;
+        uint64_t in_flight_peak;
+    };
+
+    namespace detail {
+        class RequestMetrics;
+
+        //uv_hrtime() of each status transition of a request, kept with whatever is tracking it
+        struct RequestTimes {
+            uint64_t enqueued = 0;
+            uint64_t started  = 0;
+            uint64_t finished = 0;
+
+            //Where it's counted, until it's completed
+            RequestMetrics *metrics = nullptr;
+        };
+
+        //Recording takes a few relaxed atomic adds, and snapshots can be taken from any thread
+        class AtomicHistogram {
+            protected:
+                std::atomic<uint64_t> count;
+                std::atomic<uint64_t> sum;
+                std::atomic<uint64_t> max;
+
+                std::atomic<uint64_t> buckets[Histogram::BUCKETS];
+
+                inline static size_t bucket_of( uint64_t v ) noexcept {
+                    if( v == 0 ) {
+                        return 0;
+                    }
+#if defined(__GNUC__) || defined(__clang__)
+                    return 64 - (size_t)__builtin_clzll( v );
+#else
+                    size_t k = 0;
+
+                    while( v != 0 ) {
+                        v >>= 1;
+                        ++k;
+                    }
+
+                    return k;
+#endif
+                }
+
+            public:
+                inline AtomicHistogram() noexcept
+                    : count( 0 ), sum( 0 ), max( 0 ) {
+                    for( auto &b : this->buckets ) {
+                        b.store( 0, std::memory_order_relaxed );
+                    }
+                }
+
+                AtomicHistogram( const AtomicHistogram & ) = delete;
+
+                inline void record( uint64_t v ) noexcept {
+                    this->buckets[bucket_of( v )].fetch_add( 1, std::memory_order_relaxed );
+
+                    this->count.fetch_add( 1, std::memory_order_relaxed );
+                    this->sum.fetch_add( v, std::memory_order_relaxed );
+
+                    uint64_t m = this->max.load( std::memory_order_relaxed );
+
+                    while( v > m && !this->max.compare_exchange_weak( m, v, std::memory_order_relaxed )) {
+                    }
+                }
+
+                Histogram snapshot() const noexcept {
+                    Histogram h;
+
+                    h.count = this->count.load( std::memory_order_relaxed );
+                    h.sum   = this->sum.load( std::memory_order_relaxed );
+                    h.max   = this->max.load( std::memory_order_relaxed );
+
+                    for( size_t i = 0; i < Histogram::BUCKETS; ++i ) {
+                        h.buckets[i] = this->buckets[i].load( std::memory_order_relaxed );
+                    }
+
+                    return h;
+                }
+        };
+
+        /*
+         * Metrics for one kind of request on one loop. Requests are counted from when they're made on the loop thread
+         * until their callback, with the times in between filled in by whichever thread sees each transition.
+         * */
+        class RequestMetrics {
+            protected:
+                AtomicHistogram queue_wait;
+                AtomicHistogram run;
+                AtomicHistogram latency;
+                AtomicHistogram in_flight;
+
+                std::atomic<uint64_t> current;
+                std::atomic<uint64_t> peak;
+
+            public:
+                inline RequestMetrics() noexcept
+                    : current( 0 ), peak( 0 ) {
+                }
+
+                RequestMetrics( const RequestMetrics & ) = delete;
+
+                //On the loop thread, right as the request is made
+                void enqueued( RequestTimes &t ) noexcept {
+                    t.metrics  = this;
+                    t.enqueued = uv_hrtime();
+                    t.started  = 0;
+                    t.finished = 0;
+
+                    uint64_t n = this->current.fetch_add( 1, std::memory_order_relaxed ) + 1;
+
+                    this->in_flight.record( n );
+
+                    if( n > this->peak.load( std::memory_order_relaxed )) {
+                        this->peak.store( n, std::memory_order_relaxed );
+                    }
+                }
+
+                //On the loop thread, from the request's callback. Only the first call for each enqueued does anything.
+                static void completed( RequestTimes &t ) noexcept {
+                    RequestMetrics *m = t.metrics;
+
+                    if( m == nullptr ) {
+                        return;
+                    }
+
+                    t.metrics = nullptr;
+
+                    m->latency.record( uv_hrtime() - t.enqueued );
+
+                    if( t.started != 0 ) {
+                        m->queue_wait.record( t.started - t.enqueued );
+
+                        if( t.finished != 0 ) {
+                            m->run.record( t.finished - t.started );
+                        }
+                    }
+
+                    m->current.fetch_sub( 1, std::memory_order_relaxed );
+                }
+
+                RequestStats snapshot() const noexcept {
+                    return RequestStats{
+                        this->queue_wait.snapshot(),
+                        this->run.snapshot(),
+                        this->latency.snapshot(),
+                        this->in_flight.snapshot(),
+                        this->current.load( std::memory_order_relaxed ),
+                        this->peak.load( std::memory_order_relaxed )
+                    };
+                }
+        };
+    }
+}
+
+#endif //UV_METRICS_HPP
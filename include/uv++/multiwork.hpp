@@ -0,0 +1,433 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_MULTIWORK_HPP
+#define UV_MULTIWORK_HPP
+
+#include "loop.hpp"
+
+#include <vector>
+
+namespace uv {
+    namespace detail {
+        /*
+         * A single parallel_for, parallel_map or parallel_reduce. All of its chunks are allocated up front with the
+         * job, and only a limited number of them are queued on the thread-pool at once, with the next one queued from
+         * the after-work callback of each one that finishes. Everything but running the chunks is on the loop thread.
+         * */
+        class MultiJob {
+            protected:
+                struct Chunk : PoolTask {
+                    uv_work_t req;
+                    MultiJob  *job;
+                    size_t    index;
+                    size_t    begin;
+                    size_t    end;
+                };
+
+                Loop                        *owner = nullptr;
+                std::weak_ptr<Loop>         weak_owner;
+                std::shared_ptr<ThreadPool> pool;
+                std::vector<Chunk>          chunks;
+
+                size_t limit;
+                size_t next      = 0;
+                size_t in_flight = 0;
+
+                //Set by whichever chunk fails first, and read on the loop thread once every queued chunk is back
+                std::atomic_bool   failed;
+                std::error_code    ec;
+                std::exception_ptr error;
+
+                //On the thread-pool
+                virtual void run( size_t index, size_t begin, size_t end ) = 0;
+
+                //On the loop thread, once every chunk has finished, or failed
+                virtual void finish() = 0;
+
+                inline void fail( std::error_code e, std::exception_ptr ex ) {
+                    bool expected = false;
+
+                    if( this->failed.compare_exchange_strong( expected, true )) {
+                        this->ec    = e;
+                        this->error = ex;
+                    }
+                }
+
+                static void run_chunk( Chunk *c ) {
+                    if( c->job->failed.load( std::memory_order_relaxed )) {
+                        return;
+                    }
+
+                    try {
+                        c->job->run( c->index, c->begin, c->end );
+
+                    } catch( ... ) {
+                        c->job->fail( std::error_code(), std::current_exception());
+                    }
+                }
+
+                static void chunk_done( Chunk *c, int status ) {
+                    MultiJob *job = c->job;
+
+                    --job->in_flight;
+
+                    if( status != 0 ) {
+                        job->fail( make_error_code( status ), nullptr );
+                    }
+
+                    job->pump();
+                }
+
+                int queue_chunk( Chunk &c ) {
+                    if( this->pool ) {
+                        c.run = []( PoolTask *p ) {
+                            Chunk *inner = static_cast<Chunk *>(p);
+
+                            run_chunk( inner );
+
+                            /*
+                             * Pool workers don't keep the loop alive, so it may be gone by now. The job is only ever
+                             * finished and freed on the loop, so then it's left behind like anything else still
+                             * queued for a destroyed loop.
+                             * */
+                            if( auto l = inner->job->weak_owner.lock()) {
+                                loop_post( l.get(), inner, []( void *q ) {
+                                    chunk_done( static_cast<Chunk *>(q), 0 );
+                                } );
+                            }
+                        };
+
+                        this->pool->submit( &c );
+
+                        return 0;
+                    }
+
+                    return uv_queue_work( loop_handle( this->owner ), &c.req, []( uv_work_t *w ) {
+                        run_chunk( static_cast<Chunk *>(w->data));
+
+                    }, []( uv_work_t *w, int status ) {
+                        chunk_done( static_cast<Chunk *>(w->data), status );
+                    } );
+                }
+
+                void pump() {
+                    while( this->in_flight < this->limit && this->next < this->chunks.size() && !this->failed.load()) {
+                        int res = this->queue_chunk( this->chunks[this->next++] );
+
+                        if( res < 0 ) {
+                            this->fail( make_error_code( res ), nullptr );
+
+                        } else {
+                            ++this->in_flight;
+                        }
+                    }
+
+                    if( this->in_flight == 0 && ( this->next == this->chunks.size() || this->failed.load())) {
+                        this->finish();
+
+                        delete this;
+                    }
+                }
+
+            public:
+                inline MultiJob( size_t n, size_t grain, size_t max_in_flight )
+                    : limit( max_in_flight ), failed( false ) {
+                    size_t count = grain == 0 ? 0 : ( n + grain - 1 ) / grain;
+
+                    this->chunks.resize( count );
+
+                    for( size_t i = 0; i < count; ++i ) {
+                        Chunk &c = this->chunks[i];
+
+                        c.req.data = &c;
+                        c.job      = this;
+                        c.index    = i;
+                        c.begin    = i * grain;
+                        c.end      = std::min( n, c.begin + grain );
+                    }
+                }
+
+                MultiJob( const MultiJob & ) = delete;
+
+                inline size_t num_chunks() const noexcept {
+                    return this->chunks.size();
+                }
+
+                //Chunks run on the pool if there is one, or the libuv thread-pool otherwise
+                inline void bind( const std::shared_ptr<Loop> &l, std::shared_ptr<ThreadPool> p ) noexcept {
+                    this->owner      = l.get();
+                    this->weak_owner = l;
+                    this->pool       = std::move( p );
+                }
+
+                //On the loop thread
+                inline void start() {
+                    this->pump();
+                }
+
+                virtual ~MultiJob() = default;
+        };
+
+        template <typename Result>
+        class MultiJobBase : public MultiJob {
+            protected:
+                Promise<Result> promise;
+
+                //Fails the promise, returning false, if any chunk failed
+                inline bool settle_failure() {
+                    if( !this->failed.load()) {
+                        return false;
+                    }
+
+                    if( this->error ) {
+                        this->promise.set_exception( this->error );
+
+                    } else {
+                        this->promise.set_error( this->ec );
+                    }
+
+                    return true;
+                }
+
+            public:
+                using MultiJob::MultiJob;
+
+                inline Future<Result> get_future() {
+                    return this->promise.get_future();
+                }
+        };
+
+        template <typename Functor>
+        class ForJob final : public MultiJobBase<void> {
+            protected:
+                Functor f;
+                size_t  offset;
+
+                void run( size_t, size_t begin, size_t end ) override {
+                    for( size_t i = begin; i < end; ++i ) {
+                        this->f( this->offset + i );
+                    }
+                }
+
+                void finish() override {
+                    if( !this->settle_failure()) {
+                        this->promise.set_value();
+                    }
+                }
+
+            public:
+                inline ForJob( size_t first, size_t n, size_t grain, size_t max_in_flight, Functor &&fn )
+                    : MultiJobBase<void>( n, grain, max_in_flight ), f( std::move( fn )), offset( first ) {
+                }
+        };
+
+        template <typename T, typename R, typename Functor>
+        class MapJob final : public MultiJobBase<std::vector<R>> {
+            protected:
+                /*
+                 * Chunks write their results side by side from different threads, which a std::vector<bool> would pack
+                 * into the same words. Wrapping each one keeps them apart until they're handed over.
+                 * */
+                struct Result {
+                    R value;
+                };
+
+                std::vector<T>      input;
+                std::vector<Result> output;
+                Functor             f;
+
+                void run( size_t, size_t begin, size_t end ) override {
+                    for( size_t i = begin; i < end; ++i ) {
+                        this->output[i].value = this->f( this->input[i] );
+                    }
+                }
+
+                void finish() override {
+                    if( this->settle_failure()) {
+                        return;
+                    }
+
+                    try {
+                        std::vector<R> results;
+
+                        results.reserve( this->output.size());
+
+                        for( Result &r : this->output ) {
+                            results.push_back( std::move( r.value ));
+                        }
+
+                        this->promise.set_value( std::move( results ));
+
+                    } catch( ... ) {
+                        this->promise.set_exception( std::current_exception());
+                    }
+                }
+
+            public:
+                inline MapJob( std::vector<T> &&in, size_t grain, size_t max_in_flight, Functor &&fn )
+                    : MultiJobBase<std::vector<R>>( in.size(), grain, max_in_flight ),
+                      input( std::move( in )), output( input.size()), f( std::move( fn )) {
+                }
+        };
+
+        template <typename T, typename R, typename Reduce, typename Combine>
+        class ReduceJob final : public MultiJobBase<R> {
+            protected:
+                std::vector<T> input;
+                std::vector<R> partials;
+                R              init;
+                Reduce         reduce;
+                Combine        combine;
+
+                void run( size_t index, size_t begin, size_t end ) override {
+                    R acc = this->init;
+
+                    for( size_t i = begin; i < end; ++i ) {
+                        acc = this->reduce( std::move( acc ), this->input[i] );
+                    }
+
+                    this->partials[index] = std::move( acc );
+                }
+
+                //Partials are combined in order, so combine only has to be associative
+                void finish() override {
+                    if( this->settle_failure()) {
+                        return;
+                    }
+
+                    try {
+                        R total = std::move( this->init );
+
+                        for( R &p : this->partials ) {
+                            total = this->combine( std::move( total ), std::move( p ));
+                        }
+
+                        this->promise.set_value( std::move( total ));
+
+                    } catch( ... ) {
+                        this->promise.set_exception( std::current_exception());
+                    }
+                }
+
+            public:
+                inline ReduceJob( std::vector<T> &&in, size_t grain, size_t max_in_flight, R &&identity, Reduce &&r, Combine &&c )
+                    : MultiJobBase<R>( in.size(), grain, max_in_flight ),
+                      input( std::move( in )), init( std::move( identity )), reduce( std::move( r )), combine( std::move( c )) {
+                    this->partials.resize( this->num_chunks(), this->init );
+                }
+        };
+    }
+
+    /*
+     * Splits a batch of CPU work into chunks across the thread-pool, and completes a single uv::Future on the loop
+     * thread once every chunk is done.
+     *
+     * Chunks are plain uv_work_t requests allocated together with the job, rather than a Work each, so even batches
+     * of small items are worth splitting up. At most max_in_flight chunks are queued at once, which leaves room in the
+     * pool for everything else. A grain of zero splits the input into four chunks per worker. They don't go through the
+     * loop's priority classes for Work, and aren't counted in Loop::work_stats.
+     *
+     * Given a ThreadPool, chunks are run there instead, and leave the libuv thread-pool free for filesystem requests.
+     *
+     * If a chunk throws, nothing more is queued, and the future fails with that exception.
+     * */
+    class MultiWork final : public std::enable_shared_from_this<MultiWork>,
+                            public detail::FromLoop {
+        protected:
+            std::shared_ptr<ThreadPool> _pool;
+
+            size_t max_in_flight;
+
+            inline size_t workers() const noexcept {
+                return this->_pool ? this->_pool->size() : Work::num_workers();
+            }
+
+            inline size_t grain_for( size_t n, size_t grain ) const noexcept {
+                if( grain != 0 ) {
+                    return grain;
+                }
+
+                size_t chunks = this->workers() * 4;
+
+                return std::max<size_t>(( n + chunks - 1 ) / chunks, 1 );
+            }
+
+            //Starts the job on the loop thread, and hands back its future
+            template <typename Result>
+            Future<Result> launch( detail::MultiJobBase<Result> *job ) {
+                Future<Result> ret = job->get_future();
+
+                job->bind( this->loop(), this->_pool );
+
+                if( this->on_loop_thread()) {
+                    job->start();
+
+                } else {
+                    detail::loop_post( this->loop().get(), job, []( void *p ) {
+                        static_cast<detail::MultiJob *>(p)->start();
+                    } );
+                }
+
+                return ret;
+            }
+
+        public:
+            /*
+             * Zero allows as many chunks in flight as there are workers. Chunks run on the given pool, or the libuv
+             * thread-pool without one.
+             * */
+            inline explicit MultiWork( std::shared_ptr<Loop> l, size_t max_in_flight = 0, std::shared_ptr<ThreadPool> pool = nullptr )
+                : _pool( std::move( pool )) {
+                this->_loop_init( l );
+
+                this->max_in_flight = max_in_flight == 0 ? this->workers() : max_in_flight;
+            }
+
+            static inline std::shared_ptr<MultiWork> make( std::shared_ptr<Loop> l, size_t max_in_flight = 0 ) {
+                return std::make_shared<MultiWork>( std::move( l ), max_in_flight );
+            }
+
+            static inline std::shared_ptr<MultiWork> make( std::shared_ptr<Loop> l, std::shared_ptr<ThreadPool> pool, size_t max_in_flight = 0 ) {
+                return std::make_shared<MultiWork>( std::move( l ), max_in_flight, std::move( pool ));
+            }
+
+            //Calls f( i ) for every i in [begin, end)
+            template <typename Functor>
+            Future<void> parallel_for( size_t begin, size_t end, size_t grain, Functor &&f ) {
+                typedef detail::ForJob<typename std::decay<Functor>::type> Job;
+
+                size_t n = end > begin ? end - begin : 0;
+
+                return this->launch<void>( new Job( begin, n, this->grain_for( n, grain ), this->max_in_flight, std::forward<Functor>( f )));
+            }
+
+            //Results are written in place, so they have to be default constructible
+            template <typename T, typename Functor,
+                      typename R = typename std::decay<decltype( std::declval<Functor &>()( std::declval<const T &>()))>::type>
+            Future<std::vector<R>> parallel_map( std::vector<T> input, size_t grain, Functor &&f ) {
+                typedef detail::MapJob<T, R, typename std::decay<Functor>::type> Job;
+
+                size_t g = this->grain_for( input.size(), grain );
+
+                return this->launch<std::vector<R>>( new Job( std::move( input ), g, this->max_in_flight, std::forward<Functor>( f )));
+            }
+
+            /*
+             * Each chunk folds its items into a copy of identity with reduce( acc, item ), and the chunks are then
+             * folded together in order with combine( acc, partial ) on the loop thread.
+             * */
+            template <typename T, typename R, typename Reduce, typename Combine>
+            Future<R> parallel_reduce( std::vector<T> input, size_t grain, R identity, Reduce &&reduce, Combine &&combine ) {
+                typedef detail::ReduceJob<T, R, typename std::decay<Reduce>::type, typename std::decay<Combine>::type> Job;
+
+                size_t g = this->grain_for( input.size(), grain );
+
+                return this->launch<R>( new Job( std::move( input ), g, this->max_in_flight, std::move( identity ),
+                                                 std::forward<Reduce>( reduce ), std::forward<Combine>( combine )));
+            }
+    };
+}
+
+#endif //UV_MULTIWORK_HPP
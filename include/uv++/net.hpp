@@ -80,51 +80,89 @@ namespace uv {
             }
         };
 
-        inline void set_ip4_addr( sockaddr_in *addr, const std::string &ip, int port ) {
+        /*
+         * The overloads taking a std::error_code never throw, for parsing addresses that may well be invalid, like
+         * ones coming straight from clients.
+         * */
+        inline bool set_ip4_addr( sockaddr_in *addr, const std::string &ip, int port, std::error_code &ec ) noexcept {
             assert( addr != nullptr );
 
-            int res = uv_ip4_addr( ip.c_str(), port, addr );
+            return ::uv::detail::set_error( ec, uv_ip4_addr( ip.c_str(), port, addr ));
+        }
 
-            if( res != 0 ) {
-                throw ::uv::Exception( res );
+        inline void set_ip4_addr( sockaddr_in *addr, const std::string &ip, int port ) {
+            std::error_code ec;
+
+            if( !set_ip4_addr( addr, ip, port, ec )) {
+                throw ::uv::Exception( ec.value());
             }
         }
 
+        inline sockaddr_in ip4_addr( const std::string &ip, int port, std::error_code &ec ) noexcept {
+            sockaddr_in tmp{};
+            set_ip4_addr( &tmp, ip, port, ec );
+            return tmp;
+        }
+
         inline sockaddr_in ip4_addr( const std::string &ip, int port ) {
             sockaddr_in tmp;
             set_ip4_addr( &tmp, ip, port );
             return tmp;
         }
 
-        inline void set_ip6_addr( sockaddr_in6 *addr, const std::string &ip, int port ) {
+        inline bool set_ip6_addr( sockaddr_in6 *addr, const std::string &ip, int port, std::error_code &ec ) noexcept {
             assert( addr != nullptr );
 
-            int res = uv_ip6_addr( ip.c_str(), port, addr );
+            return ::uv::detail::set_error( ec, uv_ip6_addr( ip.c_str(), port, addr ));
+        }
 
-            if( res != 0 ) {
-                throw ::uv::Exception( res );
+        inline void set_ip6_addr( sockaddr_in6 *addr, const std::string &ip, int port ) {
+            std::error_code ec;
+
+            if( !set_ip6_addr( addr, ip, port, ec )) {
+                throw ::uv::Exception( ec.value());
             }
         }
 
+        inline sockaddr_in6 ip6_addr( const std::string &ip, int port, std::error_code &ec ) noexcept {
+            sockaddr_in6 tmp{};
+            set_ip6_addr( &tmp, ip, port, ec );
+            return tmp;
+        }
+
         inline sockaddr_in6 ip6_addr( const std::string &ip, int port ) {
             sockaddr_in6 tmp;
             set_ip6_addr( &tmp, ip, port );
             return tmp;
         }
 
-        inline void set_ip_addr( address_t *addr, const std::string &ip, int port ) {
+        inline bool set_ip_addr( address_t *addr, const std::string &ip, int port, std::error_code &ec ) noexcept {
             assert( addr != nullptr );
 
             auto af = ip.find( ':' ) == std::string::npos ? AF_INET : AF_INET6;
 
             if( af == AF_INET ) {
-                set_ip4_addr( &addr->address4, ip, port );
+                return set_ip4_addr( &addr->address4, ip, port, ec );
 
             } else {
-                set_ip6_addr( &addr->address6, ip, port );
+                return set_ip6_addr( &addr->address6, ip, port, ec );
             }
         }
 
+        inline void set_ip_addr( address_t *addr, const std::string &ip, int port ) {
+            std::error_code ec;
+
+            if( !set_ip_addr( addr, ip, port, ec )) {
+                throw ::uv::Exception( ec.value());
+            }
+        }
+
+        inline address_t ip_addr( const std::string &ip, int port, std::error_code &ec ) noexcept {
+            address_t tmp{};
+            set_ip_addr( &tmp, ip, port, ec );
+            return tmp;
+        }
+
         inline address_t ip_addr( const std::string &ip, int port ) {
             address_t tmp;
             set_ip_addr( &tmp, ip, port );
@@ -157,7 +195,7 @@ namespace uv {
             return result;
         }
 
-        void pton( const std::string &address, address_t *target ) {
+        inline bool pton( const std::string &address, address_t *target, std::error_code &ec ) noexcept {
             assert( target != nullptr );
 
             auto af = address.find( ':' ) == std::string::npos ? AF_INET : AF_INET6;
@@ -170,11 +208,21 @@ namespace uv {
                 res = uv_inet_pton( af, address.c_str(), &target->address6.sin6_addr );
             }
 
-            if( res != 0 ) {
-                throw ::uv::Exception( res );
+            if( !::uv::detail::set_error( ec, res )) {
+                return false;
             }
 
             target->address4.sin_family = af;
+
+            return true;
+        }
+
+        void pton( const std::string &address, address_t *target ) {
+            std::error_code ec;
+
+            if( !pton( address, target, ec )) {
+                throw ::uv::Exception( ec.value());
+            }
         }
 
         inline address_t pton( const std::string &address ) {
@@ -185,6 +233,14 @@ namespace uv {
             return tmp;
         }
 
+        inline address_t pton( const std::string &address, std::error_code &ec ) noexcept {
+            address_t tmp{};
+
+            pton( address, &tmp, ec );
+
+            return tmp;
+        }
+
         std::vector<interface_t> interfaces() {
             uv_interface_address_t *addresses;
             int                    count;
@@ -306,6 +306,15 @@ namespace uv {
             return rss;
         }
 
+        //Zero on failure, with ec set
+        inline size_t rss_memory( std::error_code &ec ) noexcept {
+            size_t rss = 0;
+
+            ::uv::detail::set_error( ec, uv_resident_set_memory( &rss ));
+
+            return rss;
+        }
+
         inline uint64_t total_memory() {
             return uv_get_total_memory();
         }
@@ -322,6 +331,14 @@ namespace uv {
             return u;
         }
 
+        inline double uptime( std::error_code &ec ) noexcept {
+            double u = 0;
+
+            ::uv::detail::set_error( ec, uv_uptime( &u ));
+
+            return u;
+        }
+
         std::array<double, 3> loadavg() {
             std::array<double, 3> result;
 
@@ -342,6 +359,14 @@ namespace uv {
             return u;
         }
 
+        inline rusage_t rusage( std::error_code &ec ) noexcept {
+            rusage_t u{};
+
+            ::uv::detail::set_error( ec, uv_getrusage( &u ));
+
+            return u;
+        }
+
         std::vector<cpu_info_t> cpu_info() {
             uv_cpu_info_t *cpus;
             int           count;
@@ -401,6 +426,10 @@ namespace uv {
                 throw ::uv::Exception( res );
             }
         }
+
+        inline bool kill( int pid, int signum, std::error_code &ec ) noexcept {
+            return ::uv::detail::set_error( ec, uv_kill( pid, signum ));
+        }
     }
 }
 
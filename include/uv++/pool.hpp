@@ -0,0 +1,304 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_POOL_HPP
+#define UV_POOL_HPP
+
+#include "fwd.hpp"
+#include "detail/utils.hpp"
+#include "detail/lockfree.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace uv {
+    namespace detail {
+        /*
+         * Something to run on a ThreadPool. It's meant to be embedded in whatever it belongs to, so submitting work
+         * never allocates, and run is responsible for getting any result back to where it's needed.
+         * */
+        struct PoolTask {
+            //Owned by the pool while the task is queued
+            PoolTask *next = nullptr;
+
+            void (*run)( PoolTask * ) = nullptr;
+        };
+
+        struct NumPoolThreads : LazyStatic<size_t> {
+            size_t init() noexcept {
+                const char *val = std::getenv( "UV_CPU_POOL_SIZE" );
+
+                if( val != nullptr ) {
+                    return detail::clamp<size_t>( std::stoull( val ), 1, 256 );
+
+                } else {
+                    return std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+                }
+            }
+        };
+    }
+
+    /*
+     * A thread pool for CPU-bound work, separate from the libuv thread-pool, so a burst of computation can't hold up
+     * filesystem and DNS requests, and the other way around. Work and MultiWork can be pointed at one instead of libuv.
+     *
+     * Every worker has its own Chase-Lev deque. Work submitted from a worker goes onto its own deque and is run newest
+     * first, while idle workers steal the oldest work from the others. Work from any other thread goes onto a lock-free
+     * injection list, which a worker takes in one go and spreads onto its own deque for the rest to steal from.
+     *
+     * Workers only sleep once there's nothing to run or steal, and submitting only takes a lock when one is asleep.
+     *
+     * The pool must not be destroyed from one of its own workers. Anything still queued by then is run first.
+     * */
+    class ThreadPool final {
+        protected:
+            struct Worker {
+                detail::WorkStealingDeque<detail::PoolTask> deque;
+
+                std::thread thread;
+
+                //For picking where to start stealing from
+                uint32_t seed;
+            };
+
+            std::vector<std::unique_ptr<Worker>> workers;
+
+            detail::MPSCList<detail::PoolTask> injected;
+
+            //Bumped on every submit, so a worker going to sleep can tell if it missed anything
+            std::atomic<uint64_t> epoch;
+            std::atomic<size_t>   idle;
+
+            std::mutex              mutex;
+            std::condition_variable cv;
+            bool                    stopping = false;
+
+            static inline Worker *&current() noexcept {
+                static thread_local Worker *w = nullptr;
+
+                return w;
+            }
+
+            static inline ThreadPool *&current_pool() noexcept {
+                static thread_local ThreadPool *p = nullptr;
+
+                return p;
+            }
+
+            inline void wake() {
+                this->epoch.fetch_add( 1 );
+
+                if( this->idle.load() != 0 ) {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    this->cv.notify_one();
+                }
+            }
+
+            detail::PoolTask *steal( Worker *self ) noexcept {
+                size_t n = this->workers.size();
+
+                //xorshift32
+                self->seed ^= self->seed << 13;
+                self->seed ^= self->seed >> 17;
+                self->seed ^= self->seed << 5;
+
+                size_t start = self->seed % n;
+
+                for( size_t i = 0; i < n; ++i ) {
+                    Worker *victim = this->workers[( start + i ) % n].get();
+
+                    if( victim == self ) {
+                        continue;
+                    }
+
+                    //A failed steal only means someone else got there first, so keep at it while there's anything left
+                    while( !victim->deque.empty()) {
+                        if( detail::PoolTask *t = victim->deque.steal()) {
+                            return t;
+                        }
+                    }
+                }
+
+                return nullptr;
+            }
+
+            detail::PoolTask *next( Worker *self ) {
+                if( detail::PoolTask *t = self->deque.pop()) {
+                    return t;
+                }
+
+                if( !this->injected.empty()) {
+                    if( detail::PoolTask *first = this->injected.take_all()) {
+                        detail::PoolTask *rest = first->next;
+
+                        if( rest != nullptr ) {
+                            while( rest != nullptr ) {
+                                detail::PoolTask *t = rest;
+
+                                rest = rest->next;
+
+                                self->deque.push( t );
+                            }
+
+                            //Let the others know there's something to steal
+                            this->wake();
+                        }
+
+                        return first;
+                    }
+                }
+
+                return this->steal( self );
+            }
+
+            void run( Worker *self ) {
+                current()      = self;
+                current_pool() = this;
+
+                while( true ) {
+                    detail::PoolTask *t = this->next( self );
+
+                    if( t == nullptr ) {
+                        uint64_t seen = this->epoch.load();
+
+                        //Anything submitted after this second look changes the epoch, so it can't be slept through
+                        t = this->next( self );
+
+                        if( t == nullptr ) {
+                            std::unique_lock<std::mutex> lock( this->mutex );
+
+                            if( this->stopping ) {
+                                break;
+                            }
+
+                            this->idle.fetch_add( 1 );
+
+                            this->cv.wait( lock, [this, seen] {
+                                return this->stopping || this->epoch.load() != seen;
+                            } );
+
+                            this->idle.fetch_sub( 1 );
+
+                            continue;
+                        }
+                    }
+
+                    t->run( t );
+                }
+            }
+
+        public:
+            //Zero uses UV_CPU_POOL_SIZE if it's set, or one thread per core
+            inline explicit ThreadPool( size_t threads = 0 )
+                : epoch( 0 ), idle( 0 ) {
+                static detail::NumPoolThreads default_threads;
+
+                if( threads == 0 ) {
+                    threads = default_threads;
+                }
+
+                for( size_t i = 0; i < threads; ++i ) {
+                    this->workers.emplace_back( new Worker );
+
+                    this->workers.back()->seed = (uint32_t)( i * 2654435761u ) | 1u;
+                }
+
+                for( auto &w : this->workers ) {
+                    Worker *self = w.get();
+
+                    self->thread = std::thread( [this, self] {
+                        this->run( self );
+                    } );
+                }
+            }
+
+            ThreadPool( const ThreadPool & ) = delete;
+
+            static inline std::shared_ptr<ThreadPool> make( size_t threads = 0 ) {
+                return std::make_shared<ThreadPool>( threads );
+            }
+
+            //A pool for the whole process, started the first time it's asked for
+            static std::shared_ptr<ThreadPool> shared() {
+                static std::shared_ptr<ThreadPool> pool = make();
+
+                return pool;
+            }
+
+            inline size_t size() const noexcept {
+                return this->workers.size();
+            }
+
+            //Whether the calling thread is one of this pool's workers
+            inline bool on_pool_thread() const noexcept {
+                return current_pool() == this;
+            }
+
+            //From any thread. The task must stay alive until it has been run.
+            void submit( detail::PoolTask *t ) {
+                assert( t != nullptr && t->run != nullptr );
+
+                if( this->on_pool_thread()) {
+                    current()->deque.push( t );
+
+                } else {
+                    this->injected.push( t );
+                }
+
+                this->wake();
+            }
+
+            //Like submit, but for any functor, at the cost of allocating a task for it
+            template <typename Functor>
+            void post( Functor &&f ) {
+                typedef typename std::decay<Functor>::type F;
+
+                struct FunctorTask : detail::PoolTask {
+                    F f;
+
+                    inline explicit FunctorTask( Functor &&fn )
+                        : f( std::forward<Functor>( fn )) {
+                    }
+                };
+
+                FunctorTask *t = new FunctorTask( std::forward<Functor>( f ));
+
+                t->run = []( detail::PoolTask *p ) {
+                    std::unique_ptr<FunctorTask> fp( static_cast<FunctorTask *>(p));
+
+                    try {
+                        fp->f();
+
+                    } catch( ... ) {
+                    }
+                };
+
+                this->submit( t );
+            }
+
+            ~ThreadPool() {
+                assert( !this->on_pool_thread());
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    this->stopping = true;
+                }
+
+                this->cv.notify_all();
+
+                for( auto &w : this->workers ) {
+                    if( w->thread.joinable()) {
+                        w->thread.join();
+                    }
+                }
+            }
+    };
+}
+
+#endif //UV_POOL_HPP
@@ -0,0 +1,349 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_RCU_HPP
+#define UV_RCU_HPP
+
+#include "loop.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace uv {
+    /*
+     * Read-copy-update domain shared by a set of loops.
+     *
+     * Every attached loop gets a Check handle that bumps a counter once per loop iteration. Since the loop thread only
+     * runs one callback at a time, once that counter has moved no callback on that loop can still be holding a pointer
+     * it read before then. Old versions are kept until every attached loop has moved past the point they were retired
+     * at, and are then freed from whichever loop's check hook notices first.
+     *
+     * A loop blocked waiting on I/O never gets to its check hook, so writers wake every loop after retiring something.
+     * */
+    class RcuDomain : public std::enable_shared_from_this<RcuDomain> {
+        protected:
+            struct Participant {
+                std::weak_ptr<Loop>    loop;
+                std::shared_ptr<Check> hook;
+
+                alignas( 64 ) std::atomic<uint64_t> quiescent;
+
+                std::atomic_bool detached;
+
+                inline Participant( std::shared_ptr<Loop> l )
+                    : loop( l ), quiescent( 0 ), detached( false ) {
+                }
+            };
+
+            struct Retired {
+                void *ptr;
+
+                void (*deleter)( void * );
+
+                std::vector<std::pair<std::shared_ptr<Participant>, uint64_t>> snapshot;
+
+                inline bool expired() const noexcept {
+                    for( auto &s : this->snapshot ) {
+                        if( !s.first->detached.load( std::memory_order_seq_cst ) &&
+                            s.first->quiescent.load( std::memory_order_seq_cst ) == s.second ) {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+            };
+
+            std::mutex                                mutex;
+            std::vector<std::shared_ptr<Participant>> participants;
+            std::vector<Retired>                      retired;
+            std::atomic<size_t>                       pending;
+
+        public:
+            inline RcuDomain() noexcept
+                : pending( 0 ) {
+            }
+
+            RcuDomain( const RcuDomain & ) = delete;
+
+            static inline std::shared_ptr<RcuDomain> make_domain() {
+                return std::make_shared<RcuDomain>();
+            }
+
+            /*
+             * Adds a loop to the domain. Any loop that reads from an Rcu in this domain has to be attached to it.
+             * */
+            void attach( std::shared_ptr<Loop> l ) {
+                auto p = std::make_shared<Participant>( l );
+
+                std::weak_ptr<RcuDomain> weak = this->shared_from_this();
+
+                p->hook = l->check( [p, weak] {
+                    //Only this loop's thread writes the counter
+                    p->quiescent.store( p->quiescent.load( std::memory_order_relaxed ) + 1, std::memory_order_seq_cst );
+
+                    if( auto domain = weak.lock()) {
+                        if( domain->pending.load( std::memory_order_relaxed ) != 0 ) {
+                            domain->reclaim();
+                        }
+                    }
+                } );
+
+                std::lock_guard<std::mutex> lock( this->mutex );
+
+                this->participants.push_back( p );
+            }
+
+            void detach( const std::shared_ptr<Loop> &l ) {
+                std::shared_ptr<Participant> p;
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    for( auto it = this->participants.begin(); it != this->participants.end(); ++it ) {
+                        if((*it)->loop.lock() == l ) {
+                            p = *it;
+
+                            this->participants.erase( it );
+
+                            break;
+                        }
+                    }
+                }
+
+                if( p ) {
+                    p->detached.store( true, std::memory_order_seq_cst );
+
+                    p->hook->close( [] {} );
+                }
+            }
+
+            /*
+             * Hands an old version over to the domain, to be deleted once no loop can still be reading it.
+             *
+             * This must come after the new version is visible, which the seq_cst exchange in Rcu::publish ensures.
+             * */
+            void retire( void *ptr, void (*deleter)( void * )) {
+                std::vector<std::shared_ptr<Loop>> wake;
+
+                {
+                    std::lock_guard<std::mutex> lock( this->mutex );
+
+                    Retired r{ ptr, deleter, {}};
+
+                    r.snapshot.reserve( this->participants.size());
+
+                    for( auto &p : this->participants ) {
+                        r.snapshot.emplace_back( p, p->quiescent.load( std::memory_order_seq_cst ));
+
+                        if( auto l = p->loop.lock()) {
+                            wake.push_back( std::move( l ));
+                        }
+                    }
+
+                    this->retired.push_back( std::move( r ));
+
+                    this->pending.fetch_add( 1, std::memory_order_relaxed );
+                }
+
+                //Make sure every loop goes around at least once more, even if it's idle
+                for( auto &l : wake ) {
+                    l->post( nullptr, []( void * ) {} );
+                }
+            }
+
+            /*
+             * Frees every retired version that's past its grace period, and returns how many were freed.
+             *
+             * This is called automatically from the check hooks, but it can be called from anywhere.
+             * */
+            size_t reclaim() {
+                std::vector<Retired> done;
+
+                {
+                    std::unique_lock<std::mutex> lock( this->mutex, std::try_to_lock );
+
+                    //Someone else is already on it, or a writer is busy, so leave it for the next iteration
+                    if( !lock.owns_lock()) {
+                        return 0;
+                    }
+
+                    auto it = std::partition( this->retired.begin(), this->retired.end(), []( const Retired &r ) {
+                        return !r.expired();
+                    } );
+
+                    std::move( it, this->retired.end(), std::back_inserter( done ));
+
+                    this->retired.erase( it, this->retired.end());
+
+                    this->pending.store( this->retired.size(), std::memory_order_relaxed );
+                }
+
+                //Deleters are run without the lock, in case they do anything interesting
+                for( Retired &r : done ) {
+                    r.deleter( r.ptr );
+                }
+
+                return done.size();
+            }
+
+            inline size_t pending_count() const noexcept {
+                return this->pending.load( std::memory_order_relaxed );
+            }
+
+            /*
+             * Versions still in their grace period aren't just deleted, since an attached loop could be reading one
+             * right now. They're handed to a task posted to every loop that hasn't moved past them yet, and the last
+             * of those to run deletes them, since a loop running a posted task can't be in the middle of anything else.
+             * */
+            ~RcuDomain() {
+                struct Drain {
+                    std::vector<Retired> retired;
+                    std::atomic<size_t>  left;
+
+                    static void run( void *p ) {
+                        Drain *d = static_cast<Drain *>(p);
+
+                        if( d->left.fetch_sub( 1 ) == 1 ) {
+                            for( Retired &r : d->retired ) {
+                                r.deleter( r.ptr );
+                            }
+
+                            delete d;
+                        }
+                    }
+                };
+
+                std::vector<std::shared_ptr<Loop>> waiting;
+
+                for( auto &p : this->participants ) {
+                    p->hook->close( [] {} );
+
+                    bool behind = false;
+
+                    for( Retired &r : this->retired ) {
+                        for( auto &snap : r.snapshot ) {
+                            if( snap.first == p && p->quiescent.load( std::memory_order_seq_cst ) == snap.second ) {
+                                behind = true;
+                            }
+                        }
+                    }
+
+                    if( behind ) {
+                        if( auto l = p->loop.lock()) {
+                            waiting.push_back( std::move( l ));
+                        }
+                    }
+                }
+
+                if( waiting.empty()) {
+                    for( Retired &r : this->retired ) {
+                        r.deleter( r.ptr );
+                    }
+
+                } else {
+                    Drain *d = new Drain;
+
+                    d->retired.swap( this->retired );
+                    d->left.store( waiting.size());
+
+                    for( auto &l : waiting ) {
+                        l->post( d, &Drain::run );
+                    }
+                }
+            }
+    };
+
+    /*
+     * A value that's read often from many loops, and replaced rarely from any thread.
+     *
+     * Reading is a single pointer load, and the pointer stays valid until the callback that read it returns,
+     * as long as it's read on a loop attached to the domain. Writers never modify the current value, they publish
+     * a new one and the old one is deleted after a grace period.
+     * */
+    template <typename T>
+    class Rcu {
+        protected:
+            std::shared_ptr<RcuDomain> domain;
+            std::atomic<T *>           current;
+
+            //Only for update(), so concurrent read-modify-writes aren't lost
+            std::mutex write_mutex;
+
+            static void deleter( void *p ) {
+                delete static_cast<T *>(p);
+            }
+
+        public:
+            typedef T value_type;
+
+            //Starts out with the given value, which may be null if readers are ready for that
+            inline Rcu( std::shared_ptr<RcuDomain> d, std::unique_ptr<T> initial ) noexcept
+                : domain( d ), current( initial.release()) {
+            }
+
+            //Constructs the initial value in place, so Rcu<T>( domain ) starts out with a default constructed T
+            template <typename... Args>
+            inline Rcu( std::shared_ptr<RcuDomain> d, Args &&... args )
+                : domain( d ), current( new T( std::forward<Args>( args )... )) {
+            }
+
+            Rcu( const Rcu & ) = delete;
+
+            inline const T *get() const noexcept {
+                return this->current.load( std::memory_order_acquire );
+            }
+
+            inline const T *operator->() const noexcept {
+                return this->get();
+            }
+
+            inline const T &operator*() const noexcept {
+                return *this->get();
+            }
+
+            //Replaces the current value from any thread, retiring the old one
+            void publish( std::unique_ptr<T> next ) {
+                T *old = this->current.exchange( next.release(), std::memory_order_seq_cst );
+
+                if( old != nullptr ) {
+                    this->domain->retire( old, &Rcu::deleter );
+                }
+            }
+
+            template <typename... Args>
+            inline void emplace( Args &&... args ) {
+                this->publish( std::make_unique<T>( std::forward<Args>( args )... ));
+            }
+
+            /*
+             * Copies the current value, lets the functor modify the copy, and publishes it.
+             * Concurrent updates are serialized so none of them are lost.
+             * */
+            template <typename Functor>
+            void update( Functor f ) {
+                std::lock_guard<std::mutex> lock( this->write_mutex );
+
+                const T *c = this->get();
+
+                std::unique_ptr<T> next = c != nullptr ? std::make_unique<T>( *c ) : std::make_unique<T>();
+
+                f( *next );
+
+                this->publish( std::move( next ));
+            }
+
+            inline std::shared_ptr<RcuDomain> get_domain() const noexcept {
+                return this->domain;
+            }
+
+            //Assumes nobody is reading it anymore
+            ~Rcu() {
+                delete this->current.load( std::memory_order_relaxed );
+            }
+    };
+}
+
+#endif //UV_RCU_HPP
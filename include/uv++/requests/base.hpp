@@ -7,6 +7,8 @@
 
 
 #include "../exception.hpp"
+#include "../cancel.hpp"
+#include "../metrics.hpp"
 #include "../detail/async.hpp"
 
 #include "../detail/data.hpp"
@@ -93,9 +95,47 @@ namespace uv {
             std::shared_ptr<request_t> _request;
             std::atomic_int            _status;
 
+            //Bumped each time the request is made, so a cancel meant for an earlier use of it can tell
+            std::atomic<uint64_t> _generation;
+
+            //When the request was made, and started and finished on a thread if it runs on one, for Loop::request_stats
+            detail::RequestTimes _times;
+
             //Implemented in derived classes
             virtual void _init() = 0;
 
+            /*
+             * Cancels the request with uv_cancel once the token is cancelled, if it's still pending by then, and returns
+             * the subscription for the finished request to unsubscribe with.
+             *
+             * The cancel is always posted to the loop, even from the loop thread, so it's queued behind the task that
+             * actually makes the request, and never sees a request libuv doesn't know about yet. By the time it runs,
+             * the request may have finished and been made again, so it only cancels the same use it was made for.
+             *
+             * Called once each time the request is made, with or without a token.
+             * */
+            uint64_t cancel_with( const CancellationToken &token ) {
+                uint64_t generation = this->_generation.fetch_add( 1 ) + 1;
+
+                if( !token.can_be_cancelled()) {
+                    return 0;
+                }
+
+                std::weak_ptr<derived_type> weak = std::static_pointer_cast<derived_type>( this->shared_from_this());
+
+                return token.subscribe( [weak, generation]( int ) {
+                    if( auto self = weak.lock()) {
+                        self->loop()->post( [weak, generation] {
+                            if( auto inner = weak.lock()) {
+                                if( inner->_generation.load() == generation && inner->is_pending()) {
+                                    inner->cancel();
+                                }
+                            }
+                        } );
+                    }
+                } );
+            }
+
         private:
             typedef typename detail::UserDataAccess<RequestData, R>::handle_t handle_t;
 
@@ -110,7 +150,8 @@ namespace uv {
         public:
             inline Request() noexcept
                 : _request( new request_t ),
-                  _status( REQUEST_IDLE ) {
+                  _status( REQUEST_IDLE ),
+                  _generation( 0 ) {
             }
 
             inline void init( std::shared_ptr<Loop> l ) {
@@ -14,6 +14,33 @@ namespace uv {
         void handle_fs_req( uv_fs_t *req, int status ) noexcept {
 
         }
+
+        //Strings are kept by value until the request is made on the loop thread, then passed as C strings
+        inline const char *fs_arg( const std::string &s ) noexcept {
+            return s.c_str();
+        }
+
+        inline const char *fs_arg( std::string &s ) noexcept {
+            return s.c_str();
+        }
+
+        template <typename T>
+        inline T &&fs_arg( T &&t ) noexcept {
+            return std::forward<T>( t );
+        }
+
+        template <typename T, typename Transform>
+        struct FSContinuation {
+            std::promise<T> result;
+            Transform       transform;
+
+            CancellationToken token;
+            uint64_t          subscription = 0;
+
+            inline FSContinuation( Transform t )
+                : transform( std::move( t )) {
+            }
+        };
     }
 
     namespace fs {
@@ -36,48 +63,84 @@ namespace uv {
                     this->cancel();
                 }
 
+                //The finished request itself is the result, and it's up to whoever gets it to call uv_fs_req_cleanup
                 template <typename Functor, typename... Args>
                 std::future<request_t *> promisify( Functor uf, Args... args ) {
+                    return this->fulfil<request_t *>( CancellationToken(), []( uv_fs_t *req ) {
+                        return req;
+                    }, uf, std::move( args )... );
+                }
+
+                /*
+                 * Makes the request, and the transform turns the finished request into the result right in the libuv
+                 * callback, where the promise is satisfied too. The transform is responsible for calling
+                 * uv_fs_req_cleanup on success, and failures are cleaned up here.
+                 * */
+                template <typename T, typename Transform, typename Functor, typename... Args>
+                std::future<T> fulfil( const CancellationToken &token, Transform t, Functor uf, Args... args ) {
+                    typedef detail::FSContinuation<T, Transform> Cont;
+
+                    if( token.is_cancelled()) {
+                        this->_status = REQUEST_CANCELLED;
+
+                        return detail::make_exception_future<T>( ::uv::Exception( token.reason()));
+                    }
+
                     this->_status = REQUEST_PENDING;
 
-                    auto r = std::make_shared<std::promise<request_t *>>();
+                    auto c = std::make_shared<Cont>( std::move( t ));
+
+                    this->internal_data->continuation = c;
 
-                    this->internal_data->continuation = r;
+                    auto result = c->result.get_future();
+
+                    c->token        = token;
+                    c->subscription = this->cancel_with( token );
 
                     auto cb = [uf, this]( Args... inner_args ) -> void {
-                        uf( this->loop_handle(), this->request(), std::forward<Args>( inner_args )..., []( uv_fs_t *req ) {
+                        detail::loop_request_metrics( this->loop().get(), UV_FS )->enqueued( this->_times );
+
+                        int res = uf( this->loop_handle(), this->request(), detail::fs_arg( inner_args )..., []( uv_fs_t *req ) {
                             std::weak_ptr<RequestData> *d = static_cast<std::weak_ptr<RequestData> *>(req->data);
 
                             if( d != nullptr ) {
                                 if( auto data = d->lock()) {
                                     if( auto self = data->self.lock()) {
+                                        detail::RequestMetrics::completed( self->_times );
+
                                         int expect_pending = REQUEST_PENDING;
 
                                         self->_status.compare_exchange_strong( expect_pending, REQUEST_FINISHED );
 
-                                        auto *p = static_cast<std::promise<request_t *> *>(data->continuation.get());
+                                        Cont *sc = static_cast<Cont *>(data->continuation.get());
 
-                                        if( expect_pending == REQUEST_PENDING ) {
-                                            int res = (int)req->result;
+                                        sc->token.unsubscribe( sc->subscription );
 
-                                            if( res < 0 ) {
-                                                uv_fs_req_cleanup( req );
+                                        int res = (int)req->result;
 
-                                                p->set_exception( std::make_exception_ptr( ::uv::Exception( res )));
+                                        if( expect_pending == REQUEST_PENDING && res >= 0 ) {
+                                            try {
+                                                sc->result.set_value( sc->transform( req ));
 
-                                            } else {
-                                                p->set_value( req );
+                                            } catch( ... ) {
+                                                sc->result.set_exception( std::current_exception());
                                             }
 
                                         } else {
                                             uv_fs_req_cleanup( req );
 
-                                            if( expect_pending == REQUEST_CANCELLED ) {
-                                                p->set_exception( std::make_exception_ptr( ::uv::Exception( UV_ECANCELED )));
+                                            if( expect_pending == REQUEST_PENDING ) {
+                                                res = res < 0 ? res : UV_UNKNOWN;
 
                                             } else {
-                                                p->set_exception( std::make_exception_ptr( ::uv::Exception( UV_UNKNOWN )));
+                                                res = expect_pending == REQUEST_CANCELLED ? UV_ECANCELED : UV_UNKNOWN;
+                                            }
+
+                                            if( res == UV_ECANCELED && sc->token.is_cancelled()) {
+                                                res = sc->token.reason();
                                             }
+
+                                            sc->result.set_exception( std::make_exception_ptr( ::uv::Exception( res )));
                                         }
                                     }
 
@@ -86,16 +149,29 @@ namespace uv {
                                 }
                             }
                         } );
+
+                        //Failing to even start the request means the callback never runs
+                        if( res < 0 ) {
+                            this->_status = REQUEST_FINISHED;
+
+                            detail::RequestMetrics::completed( this->_times );
+
+                            Cont *sc = static_cast<Cont *>(this->internal_data->continuation.get());
+
+                            sc->token.unsubscribe( sc->subscription );
+
+                            sc->result.set_exception( std::make_exception_ptr( ::uv::Exception( res )));
+                        }
                     };
 
                     if( this->on_loop_thread()) {
-                        cb( std::forward<Args>( args )... );
+                        cb( std::move( args )... );
 
                     } else {
-                        schedule( this->loop(), cb, std::forward<Args>( args )... );
+                        schedule( this->loop(), cb, std::move( args )... );
                     }
 
-                    return r->get_future();
+                    return result;
                 }
 
                 inline void start() noexcept {
@@ -8,6 +8,7 @@
 #include "base.hpp"
 
 #include "../detail/async.hpp"
+#include "../pool.hpp"
 
 #include <cstdlib>
 
@@ -15,17 +16,162 @@ namespace uv {
     namespace detail {
         template <typename Functor, typename Self>
         struct WorkContinuation : public AsyncContinuation<Functor, Self> {
+            typedef typename AsyncContinuation<Functor, Self>::result_type result_type;
+
             WorkContinuation( Functor f ) noexcept
-                : AsyncContinuation<Functor, Self>( f ) {
+                : AsyncContinuation<Functor, Self>( std::move( f )) {
             }
 
-            /*
-             * This is so the deferred future can be returned when after_work_cb is invoked instead of immediately
-             * when the result promise is set
-             * */
-            std::promise<void> finished;
+            //Filled in on the thread-pool by work_cb
+            Outcome<result_type> outcome;
+
+            //Only satisfied from after_work_cb, on the loop thread, so the result is ready once the request is finished
+            std::promise<result_type> finished;
+
+            //Work cancelled by the token fails with the token's reason rather than UV_ECANCELED
+            CancellationToken token;
+            uint64_t          subscription = 0;
+
+            //From after_work_cb, where valid is whether the work actually ran
+            void complete( int status, bool valid ) {
+                this->token.unsubscribe( this->subscription );
+
+                if( status == UV_ECANCELED && this->token.is_cancelled()) {
+                    this->finished.set_exception( std::make_exception_ptr( ::uv::Exception( this->token.reason())));
+
+                } else if( status != 0 ) {
+                    this->finished.set_exception( std::make_exception_ptr( ::uv::Exception( status )));
+
+                } else if( !valid || this->outcome.empty()) {
+                    //TODO: Better error message on this
+                    this->finished.set_exception( std::make_exception_ptr( ::uv::Exception( "invalid state" )));
+
+                } else {
+                    this->outcome.deliver( this->finished );
+                }
+            }
+        };
+
+        template <typename R>
+        struct work_done {
+            template <typename Done>
+            static inline void apply( Done &done, Outcome<R> &o ) {
+                done( std::move( o.value()));
+            }
         };
 
+        template <>
+        struct work_done<void> {
+            template <typename Done>
+            static inline void apply( Done &done, Outcome<void> & ) {
+                done();
+            }
+        };
+
+        //The default for Work::queue( work, done ), where failures have nowhere to go
+        struct IgnoreFailure {
+            inline void operator()( std::exception_ptr ) const noexcept {
+            }
+        };
+
+        /*
+         * For Work::queue( work, done, fail ). The callbacks are run straight from after_work_cb, so there's no
+         * promise or future in between, and the continuation itself is the only allocation.
+         * */
+        template <typename Functor, typename Self, typename Done, typename Fail>
+        struct WorkCallback : public AsyncContinuation<Functor, Self> {
+            typedef typename AsyncContinuation<Functor, Self>::result_type result_type;
+
+            Outcome<result_type> outcome;
+
+            Done done;
+            Fail fail;
+
+            WorkCallback( Functor f, Done &&d, Fail &&e ) noexcept
+                : AsyncContinuation<Functor, Self>( std::move( f )), done( std::move( d )), fail( std::move( e )) {
+            }
+
+            //Like anything else run from a libuv callback, exceptions from the callbacks themselves are dropped
+            void complete( int status, bool valid ) noexcept {
+                try {
+                    if( status != 0 ) {
+                        this->fail( std::make_exception_ptr( ::uv::Exception( status )));
+
+                    } else if( !valid || this->outcome.empty()) {
+                        this->fail( std::make_exception_ptr( ::uv::Exception( "invalid state" )));
+
+                    } else if( this->outcome.error ) {
+                        this->fail( this->outcome.error );
+
+                    } else {
+                        work_done<result_type>::apply( this->done, this->outcome );
+                    }
+
+                } catch( ... ) {
+                }
+            }
+        };
+
+        template <typename Functor>
+        struct nullary_work {
+            typedef std::integral_constant<bool, function_traits<Functor>::arity == 0> type;
+        };
+
+        struct not_work_callback {
+            typedef std::false_type type;
+        };
+
+        /*
+         * Whether queue( a, b ) is a functor with nothing to bind followed by its completion callback, rather than a
+         * functor and its single argument. Only looks at the arity when a is actually a functor.
+         * */
+        template <typename Functor, typename... Args>
+        struct is_work_callback : std::false_type {
+        };
+
+        template <typename Functor, typename Done>
+        struct is_work_callback<Functor, Done>
+            : std::conditional<std::is_base_of<CancellationToken, Functor>::value,
+                               not_work_callback, nullary_work<Functor>>::type::type {
+        };
+
+
+        /*
+         * Work queued on a ThreadPool, one for every time it's queued. Tasks can't be taken back out of the pool, so
+         * cancelling one just claims it first, and the worker skips it when it gets there.
+         * */
+        struct WorkPoolTask : PoolTask {
+            enum {
+                QUEUED = 0,
+                RUNNING,
+                CANCELLED
+            };
+
+            std::atomic_int claim;
+
+            //Weak, since nothing stops the loop from going away while the task is on the pool
+            std::weak_ptr<Loop> loop;
+
+            //Kept with the task, since a cancelled task may still be in the pool when the Work is queued again
+            RequestTimes times;
+
+            inline explicit WorkPoolTask( std::weak_ptr<Loop> l ) noexcept
+                : claim( QUEUED ), loop( std::move( l )) {
+            }
+
+            virtual ~WorkPoolTask() = default;
+        };
+
+        template <typename Cont>
+        struct WorkPoolTaskT final : WorkPoolTask {
+            //Keeps the request alive until the task is back on the loop
+            std::shared_ptr<Work> self;
+            std::shared_ptr<Cont> cont;
+
+            inline WorkPoolTaskT( std::weak_ptr<Loop> l, std::shared_ptr<Work> s, std::shared_ptr<Cont> c ) noexcept
+                : WorkPoolTask( std::move( l )), self( std::move( s )), cont( std::move( c )) {
+            }
+        };
 
         struct NumWorkers : LazyStatic<size_t> {
             size_t init() noexcept {
@@ -37,13 +183,286 @@ namespace uv {
                  * */
                 if( val != nullptr ) {
                     //1 is the minimum and 128 is the maximum as defined by libuv
-                    return clamp<size_t>( std::stoull( val ), 1, 128 );
+                    return detail::clamp<size_t>( std::stoull( val ), 1, 128 );
 
                 } else {
                     return 4; //default threadpool size for libuv
                 }
             }
         };
+
+        inline size_t num_workers() noexcept {
+            static NumWorkers num;
+
+            return num;
+        }
+    }
+
+    enum class WorkPriority : int {
+            INTERACTIVE = 0,
+            NORMAL,
+            BULK
+    };
+
+    //A snapshot of one priority class, from Loop::work_stats
+    struct WorkClassStats {
+        uint64_t queued;
+
+        //Picked up by a thread, whether or not it has finished yet
+        uint64_t started;
+        uint64_t finished;
+
+        //Waiting in the loop for room in the thread-pool right now
+        size_t waiting;
+
+        //From being queued to a thread picking it up, over everything finished so far
+        uint64_t total_wait_ns;
+        uint64_t max_wait_ns;
+
+        inline uint64_t mean_wait_ns() const noexcept {
+            return this->finished == 0 ? 0 : this->total_wait_ns / this->finished;
+        }
+    };
+
+    namespace detail {
+        enum : size_t {
+            WORK_PRIORITIES = 3
+        };
+
+        //One queued Work on its way through the loop's WorkGate, which keeps the Work alive until it's finished
+        struct WorkGateEntry {
+            WorkGateEntry *next = nullptr;
+
+            WorkGate              *gate = nullptr;
+            std::shared_ptr<Work> work;
+            WorkPriority          priority;
+
+            bool dispatched = false;
+
+            /*
+             * uv_hrtime() of when it was queued, which is set before it's given to the gate, and of when a thread
+             * started it, or zero if it never ran
+             * */
+            uint64_t enqueued = 0;
+            uint64_t started  = 0;
+
+            //Makes the actual request
+            void (*dispatch)( WorkGateEntry * ) = nullptr;
+
+            //Completes it with an error instead, when it's cancelled before ever being dispatched
+            void (*abort)( WorkGateEntry *, int ) = nullptr;
+
+            inline WorkGateEntry( WorkPriority p, std::shared_ptr<Work> w ) noexcept
+                : work( std::move( w )), priority( p ) {
+            }
+        };
+
+        /*
+         * libuv's thread-pool is a single FIFO, so a loop holds its Work back and only lets as many into the pool at a
+         * time as it has threads, taking them highest priority first. Every UV_WORK_FAIR_SHARE times, whatever has
+         * waited longest goes instead, so bulk work can't be starved. Only touched on the loop thread.
+         *
+         * Filesystem requests go straight into the pool as always, since libuv doesn't offer any way to reorder them.
+         *
+         * Only Work goes through here. MultiWork, TaskGroup::work, Loop::queue_work and fiber_work queue straight onto the
+         * libuv thread-pool, so they aren't prioritized, don't show up in the stats, and aren't counted as running.
+         * While they're busy, Work let in here can still end up waiting in libuv's own queue behind them.
+         * */
+        class WorkGate {
+            protected:
+                struct Class {
+                    WorkGateEntry *head = nullptr;
+                    WorkGateEntry *tail = nullptr;
+
+                    //Atomic only so stats can be read from any thread
+                    std::atomic<uint64_t> queued;
+                    std::atomic<uint64_t> started;
+                    std::atomic<uint64_t> finished;
+                    std::atomic<size_t>   waiting;
+                    std::atomic<uint64_t> total_wait;
+                    std::atomic<uint64_t> max_wait;
+
+                    inline Class() noexcept
+                        : queued( 0 ), started( 0 ), finished( 0 ), waiting( 0 ), total_wait( 0 ), max_wait( 0 ) {
+                    }
+                };
+
+                Class classes[WORK_PRIORITIES];
+
+                size_t   running    = 0;
+                uint64_t dispatches = 0;
+
+                WorkGateEntry *pop( size_t c ) noexcept {
+                    Class         &cls = this->classes[c];
+                    WorkGateEntry *e   = cls.head;
+
+                    cls.head = e->next;
+
+                    if( cls.head == nullptr ) {
+                        cls.tail = nullptr;
+                    }
+
+                    e->next = nullptr;
+
+                    cls.waiting.fetch_sub( 1, std::memory_order_relaxed );
+
+                    return e;
+                }
+
+                WorkGateEntry *pick() noexcept {
+                    size_t chosen = WORK_PRIORITIES;
+
+                    if( ++this->dispatches % UV_WORK_FAIR_SHARE == 0 ) {
+                        for( size_t c = 0; c < WORK_PRIORITIES; ++c ) {
+                            WorkGateEntry *h = this->classes[c].head;
+
+                            if( h != nullptr && ( chosen == WORK_PRIORITIES || h->enqueued < this->classes[chosen].head->enqueued )) {
+                                chosen = c;
+                            }
+                        }
+
+                    } else {
+                        for( size_t c = 0; c < WORK_PRIORITIES && chosen == WORK_PRIORITIES; ++c ) {
+                            if( this->classes[c].head != nullptr ) {
+                                chosen = c;
+                            }
+                        }
+                    }
+
+                    return chosen == WORK_PRIORITIES ? nullptr : this->pop( chosen );
+                }
+
+                void pump() {
+                    while( this->running < num_workers()) {
+                        WorkGateEntry *e = this->pick();
+
+                        if( e == nullptr ) {
+                            break;
+                        }
+
+                        ++this->running;
+
+                        e->dispatched = true;
+
+                        e->dispatch( e );
+                    }
+                }
+
+            public:
+                WorkGate() = default;
+
+                WorkGate( const WorkGate & ) = delete;
+
+                void enqueue( WorkGateEntry *e ) {
+                    Class &cls = this->classes[(size_t)e->priority];
+
+                    e->gate = this;
+
+                    if( cls.tail != nullptr ) {
+                        cls.tail->next = e;
+
+                    } else {
+                        cls.head = e;
+                    }
+
+                    cls.tail = e;
+
+                    cls.queued.fetch_add( 1, std::memory_order_relaxed );
+                    cls.waiting.fetch_add( 1, std::memory_order_relaxed );
+
+                    this->pump();
+                }
+
+                //Takes an entry back out before it's been let into the pool, returning false if it's too late
+                bool remove( WorkGateEntry *e ) noexcept {
+                    if( e->dispatched ) {
+                        return false;
+                    }
+
+                    Class &cls = this->classes[(size_t)e->priority];
+
+                    WorkGateEntry *prev = nullptr;
+
+                    for( WorkGateEntry *it = cls.head; it != nullptr; prev = it, it = it->next ) {
+                        if( it == e ) {
+                            if( prev != nullptr ) {
+                                prev->next = e->next;
+
+                            } else {
+                                cls.head = e->next;
+                            }
+
+                            if( cls.tail == e ) {
+                                cls.tail = prev;
+                            }
+
+                            e->next = nullptr;
+
+                            cls.waiting.fetch_sub( 1, std::memory_order_relaxed );
+
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                //From work_cb, on the thread that picked it up
+                void started( WorkGateEntry *e ) noexcept {
+                    this->classes[(size_t)e->priority].started.fetch_add( 1, std::memory_order_relaxed );
+                }
+
+                //From after_work_cb, which lets the next one in. The wait is only added here, on the loop thread.
+                void finished( WorkGateEntry *e ) {
+                    if( !e->dispatched ) {
+                        return;
+                    }
+
+                    --this->running;
+
+                    if( e->started != 0 ) {
+                        Class &cls = this->classes[(size_t)e->priority];
+
+                        uint64_t wait = e->started - e->enqueued;
+
+                        cls.finished.fetch_add( 1, std::memory_order_relaxed );
+                        cls.total_wait.fetch_add( wait, std::memory_order_relaxed );
+
+                        if( wait > cls.max_wait.load( std::memory_order_relaxed )) {
+                            cls.max_wait.store( wait, std::memory_order_relaxed );
+                        }
+                    }
+
+                    this->pump();
+                }
+
+                //From any thread
+                WorkClassStats stats( WorkPriority p ) const noexcept {
+                    const Class &cls = this->classes[(size_t)p];
+
+                    return WorkClassStats{
+                        cls.queued.load( std::memory_order_relaxed ),
+                        cls.started.load( std::memory_order_relaxed ),
+                        cls.finished.load( std::memory_order_relaxed ),
+                        cls.waiting.load( std::memory_order_relaxed ),
+                        cls.total_wait.load( std::memory_order_relaxed ),
+                        cls.max_wait.load( std::memory_order_relaxed )
+                    };
+                }
+
+                //Whatever never got into the pool is dropped along with the loop
+                ~WorkGate() {
+                    for( Class &cls : this->classes ) {
+                        while( cls.head != nullptr ) {
+                            WorkGateEntry *e = cls.head;
+
+                            cls.head = e->next;
+
+                            delete e;
+                        }
+                    }
+                }
+        };
     }
 
     class Work : public Request<uv_work_t, Work> {
@@ -53,6 +472,16 @@ namespace uv {
         protected:
             typedef typename Request<uv_work_t, Work>::RequestData RequestData;
 
+            std::shared_ptr<ThreadPool> _pool;
+
+            //The task most recently queued on the pool, only touched on the loop thread
+            detail::WorkPoolTask *_pool_task = nullptr;
+
+            WorkPriority _priority = WorkPriority::NORMAL;
+
+            //Set from being queued on the libuv thread-pool until after_work_cb, only touched on the loop thread
+            detail::WorkGateEntry *_gate = nullptr;
+
             inline void _init() noexcept {
                 //No-op
             }
@@ -62,76 +491,319 @@ namespace uv {
             }
 
         private:
+            //Before anything is changed for a new queue, like the generation cancel_with bumps
+            inline void check_submit( int last_status ) const {
+                //A task on the pool holds onto its own continuation, so there's nothing to take over
+                if( this->_pool && last_status == REQUEST_PENDING ) {
+                    throw ::uv::Exception( UV_EBUSY );
+                }
+            }
+
+            //Takes over as the continuation, and makes the request unless one is still pending to take it
             template <typename Cont>
-            void do_queue() {
-                uv_queue_work( this->loop_handle(), this->request(), []( uv_work_t *w ) {
-                    std::weak_ptr<RequestData> *d = static_cast<std::weak_ptr<RequestData> *>(w->data);
+            void submit( std::shared_ptr<Cont> c, int last_status ) {
+                this->internal_data->continuation = std::move( c );
 
-                    if( d != nullptr ) {
-                        if( auto data = d->lock()) {
-                            if( auto self = data->self.lock()) {
-                                int expect_pending = REQUEST_PENDING;
+                if( last_status != REQUEST_PENDING ) {
+                    if( !this->on_loop_thread()) {
+                        detail::loop_post( this->loop().get(), this, []( void *p ) {
+                            static_cast<Work *>(p)->do_queue<Cont>();
+                        } );
 
-                                self->_status.compare_exchange_strong( expect_pending, REQUEST_ACTIVE );
+                    } else {
+                        this->do_queue<Cont>();
+                    }
+                }
+            }
 
-                                if( expect_pending == REQUEST_PENDING ) {
-                                    data->cont<Cont>()->dispatch();
+            template <typename Cont>
+            static void work_cb( uv_work_t *w ) {
+                std::weak_ptr<RequestData> *d = static_cast<std::weak_ptr<RequestData> *>(w->data);
+
+                if( d != nullptr ) {
+                    if( auto data = d->lock()) {
+                        if( auto self = data->self.lock()) {
+                            int expect_pending = REQUEST_PENDING;
+
+                            self->_status.compare_exchange_strong( expect_pending, REQUEST_ACTIVE );
+
+                            if( expect_pending == REQUEST_PENDING ) {
+                                auto c = data->cont<Cont>();
+
+                                self->_times.started = uv_hrtime();
+
+                                if( self->_gate != nullptr ) {
+                                    self->_gate->started = self->_times.started;
+
+                                    self->_gate->gate->started( self->_gate );
                                 }
-                            }
 
-                        } else {
-                            RequestData::cleanup( w, d );
+                                c->invoke_into( c->outcome );
+
+                                self->_times.finished = uv_hrtime();
+                            }
                         }
+
+                    } else {
+                        RequestData::cleanup( w, d );
                     }
+                }
+            }
 
-                }, []( uv_work_t *w, int status ) {
-                    std::weak_ptr<RequestData> *d = static_cast<std::weak_ptr<RequestData> *>(w->data);
+            template <typename Cont>
+            static void after_work_cb( uv_work_t *w, int status ) {
+                std::weak_ptr<RequestData> *d = static_cast<std::weak_ptr<RequestData> *>(w->data);
 
-                    if( d != nullptr ) {
-                        if( auto data = d->lock()) {
-                            if( auto self = data->self.lock()) {
-                                int expect_active = REQUEST_ACTIVE;
+                if( d != nullptr ) {
+                    if( auto data = d->lock()) {
+                        if( auto self = data->self.lock()) {
+                            std::unique_ptr<detail::WorkGateEntry> entry( self->_gate );
 
-                                self->_status.compare_exchange_strong( expect_active, REQUEST_FINISHED );
+                            self->_gate = nullptr;
 
-                                auto sc = data->cont<Cont>();
+                            detail::RequestMetrics::completed( self->_times );
 
-                                if( status != 0 ) {
-                                    sc->finished.set_exception( std::make_exception_ptr( ::uv::Exception( status )));
+                            int expect_active = REQUEST_ACTIVE;
 
-                                } else if( expect_active != REQUEST_ACTIVE ) {
-                                    //TODO: Better error message on this
-                                    sc->finished.set_exception( std::make_exception_ptr( ::uv::Exception( "invalid state" )));
+                            self->_status.compare_exchange_strong( expect_active, REQUEST_FINISHED );
 
-                                } else {
-                                    sc->finished.set_value();
-                                }
+                            //Before completing, so stats already include this by the time anyone sees the result
+                            if( entry ) {
+                                entry->gate->finished( entry.get());
                             }
-                        } else {
-                            RequestData::cleanup( w, d );
+
+                            data->cont<Cont>()->complete( status, expect_active == REQUEST_ACTIVE );
                         }
+                    } else {
+                        RequestData::cleanup( w, d );
                     }
-                } );
+                }
+            }
+
+            //Goes through the loop's WorkGate, which makes the request once there's room for it
+            template <typename Cont>
+            void do_queue() {
+                if( this->_pool ) {
+                    this->pool_queue<Cont>();
+
+                    return;
+                }
+
+                Loop *l = this->loop().get();
+
+                detail::WorkGateEntry *e = new detail::WorkGateEntry( this->_priority, std::static_pointer_cast<Work>( this->shared_from_this()));
+
+                detail::loop_request_metrics( l, UV_WORK )->enqueued( this->_times );
+
+                e->enqueued = this->_times.enqueued;
+
+                e->dispatch = []( detail::WorkGateEntry *entry ) {
+                    Work *self = entry->work.get();
+
+                    int res = uv_queue_work( self->loop_handle(), self->request(), &Work::work_cb<Cont>, &Work::after_work_cb<Cont> );
+
+                    if( res < 0 ) {
+                        after_work_cb<Cont>( self->request(), res );
+                    }
+                };
+
+                e->abort = []( detail::WorkGateEntry *entry, int status ) {
+                    after_work_cb<Cont>( entry->work->request(), status );
+                };
+
+                this->_gate = e;
+
+                detail::loop_work_gate( l )->enqueue( e );
+            }
+
+            //On the loop thread, like do_queue
+            template <typename Cont>
+            void pool_queue() {
+                typedef detail::WorkPoolTaskT<Cont> Task;
+
+                std::shared_ptr<Loop> l = this->loop();
+
+                Task *t = new Task( l, std::static_pointer_cast<Work>( this->shared_from_this()),
+                                    std::static_pointer_cast<Cont>( this->internal_data->continuation ));
+
+                t->run = []( detail::PoolTask *p ) {
+                    Task *task = static_cast<Task *>(p);
+
+                    int expect_queued = Task::QUEUED;
+
+                    if( task->claim.compare_exchange_strong( expect_queued, Task::RUNNING )) {
+                        task->self->_status = REQUEST_ACTIVE;
+
+                        task->times.started = uv_hrtime();
+
+                        task->cont->invoke_into( task->cont->outcome );
+
+                        task->times.finished = uv_hrtime();
+                    }
+
+                    auto l = task->loop.lock();
+
+                    //With the loop gone there's nowhere to finish it, so just let go of the request
+                    if( !l ) {
+                        delete task;
+
+                        return;
+                    }
+
+                    detail::loop_post( l.get(), task, []( void *q ) {
+                        std::unique_ptr<Task> inner( static_cast<Task *>(q));
+
+                        Work *self = inner->self.get();
+
+                        if( self->_pool_task == inner.get()) {
+                            self->_pool_task = nullptr;
+                        }
+
+                        detail::RequestMetrics::completed( inner->times );
+
+                        if( inner->claim.load() == Task::RUNNING ) {
+                            int expect_active = REQUEST_ACTIVE;
+
+                            self->_status.compare_exchange_strong( expect_active, REQUEST_FINISHED );
+
+                            inner->cont->complete( 0, true );
+
+                        } else {
+                            inner->cont->complete( UV_ECANCELED, false );
+                        }
+                    } );
+                };
+
+                this->_pool_task = t;
+
+                detail::loop_request_metrics( l.get(), UV_WORK )->enqueued( t->times );
+
+                this->_pool->submit( t );
             }
 
         public:
             static size_t num_workers() noexcept {
-                static detail::NumWorkers num;
-
-                return num;
+                return detail::num_workers();
             }
 
             inline void start() noexcept {
                 //No-op
             }
 
+            /*
+             * Runs everything queued from now on on the given pool instead of the libuv thread-pool, or back on libuv
+             * with nullptr. Queueing again while the work is still pending on a pool throws UV_EBUSY.
+             * */
+            inline void set_pool( std::shared_ptr<ThreadPool> pool ) {
+                if( this->is_pending() || this->is_active()) {
+                    throw ::uv::Exception( UV_EBUSY );
+                }
+
+                this->_pool = std::move( pool );
+            }
+
+            inline const std::shared_ptr<ThreadPool> &pool() const noexcept {
+                return this->_pool;
+            }
+
+            /*
+             * Sets the priority for everything queued from now on. Higher priority work is let into the libuv
+             * thread-pool first, see Loop::work_stats for how long each class waits. Work on a ThreadPool ignores it.
+             * */
+            inline void set_priority( WorkPriority p ) {
+                if( this->is_pending() || this->is_active()) {
+                    throw ::uv::Exception( UV_EBUSY );
+                }
+
+                this->_priority = p;
+            }
+
+            inline WorkPriority priority() const noexcept {
+                return this->_priority;
+            }
+
+            /*
+             * Work still waiting on the loop for room in the thread-pool is just taken back out, and work on a pool is
+             * marked as cancelled if no worker has started it, rather than being removed from its queue.
+             * */
+            inline std::shared_future<void> cancel() {
+                if( !this->on_loop_thread()) {
+                    //Loop isn't complete yet here, so this can't go through schedule
+                    struct Pending {
+                        std::shared_ptr<Work> self;
+                        std::promise<void>    result;
+                    };
+
+                    Pending *p = new Pending{ std::static_pointer_cast<Work>( this->shared_from_this()), {}};
+
+                    std::shared_future<void> ret = p->result.get_future().share();
+
+                    detail::loop_post( this->loop().get(), p, []( void *q ) {
+                        std::unique_ptr<Pending> inner( static_cast<Pending *>(q));
+
+                        try {
+                            inner->self->cancel().get();
+
+                            inner->result.set_value();
+
+                        } catch( ... ) {
+                            inner->result.set_exception( std::current_exception());
+                        }
+                    } );
+
+                    return ret;
+
+                } else if( this->_gate != nullptr && this->_gate->gate->remove( this->_gate )) {
+                    this->_status = REQUEST_CANCELLED;
+
+                    //Fails the continuation just like libuv would have, without the request ever being made
+                    this->_gate->abort( this->_gate, UV_ECANCELED );
+
+                    return detail::make_ready_future();
+
+                } else if( !this->_pool ) {
+                    return Request<uv_work_t, Work>::cancel();
+                }
+
+                int expect_queued = detail::WorkPoolTask::QUEUED;
+
+                if( this->_pool_task != nullptr && this->_pool_task->claim.compare_exchange_strong( expect_queued, detail::WorkPoolTask::CANCELLED )) {
+                    this->_status = REQUEST_CANCELLED;
+
+                    return detail::make_ready_future();
+
+                } else {
+                    return detail::make_exception_future<void>( ::uv::Exception( UV_EBUSY ));
+                }
+            }
+
+            /*
+             * The functor and arguments are forwarded into the continuation, and from there moved into the functor
+             * on the thread-pool, so large or move-only arguments are never copied along the way.
+             * */
+            template <typename Functor, typename... Args,
+                      typename = typename std::enable_if<!std::is_base_of<CancellationToken, typename std::decay<Functor>::type>::value &&
+                                                         !detail::is_work_callback<typename std::decay<Functor>::type, Args...>::value>::type>
+            inline std::future<detail::fn_result_of<Functor>> queue( Functor &&f, Args &&... args ) {
+                return this->queue( CancellationToken(), std::forward<Functor>( f ), std::forward<Args>( args )... );
+            }
+
+            /*
+             * Like queue, but the work is cancelled with uv_cancel if the token is cancelled before a thread picks it
+             * up, and the future fails with the token's reason. Work that has already started runs to completion.
+             * */
             template <typename Functor, typename... Args>
-            std::future<detail::fn_result_of<Functor>> queue( Functor f, Args... args ) {
-                typedef detail::function_traits<Functor>        ft;
-                typedef typename ft::result_type                result_type;
-                typedef detail::WorkContinuation<Functor, Work> Cont;
+            std::future<detail::fn_result_of<Functor>> queue( const CancellationToken &token, Functor &&f, Args &&... args ) {
+                typedef typename std::decay<Functor>::type           functor_type;
+                typedef detail::function_traits<functor_type>        ft;
+                typedef typename ft::result_type                     result_type;
+                typedef detail::WorkContinuation<functor_type, Work> Cont;
+
+                static_assert( ft::arity >= sizeof...( Args ), "too many arguments given to Work::queue" );
 
-                static_assert( ft::arity >= sizeof...( Args ));
+                if( token.is_cancelled()) {
+                    return detail::make_exception_future<result_type>( ::uv::Exception( token.reason()));
+                }
 
                 /*
                  * This is so freaking cheating...
@@ -146,35 +818,59 @@ namespace uv {
                     throw ::uv::Exception( UV_EBUSY );
 
                 } else {
-                    auto c = std::make_shared<Cont>( f );
+                    this->check_submit( last_status );
 
-                    auto result = *c->s;
+                    auto c = std::make_shared<Cont>( std::forward<Functor>( f ));
 
-                    c->init( this->shared_from_this(), std::forward<Args>( args )... );
+                    c->store_args( std::static_pointer_cast<Work>( this->shared_from_this()), std::forward<Args>( args )... );
 
-                    this->internal_data->continuation = c;
+                    auto result = c->finished.get_future();
 
-                    if( last_status != REQUEST_PENDING ) {
-                        if( !this->on_loop_thread()) {
-                            schedule( this->loop(), [this] {
-                                this->do_queue<Cont>();
-                            } );
+                    c->token        = token;
+                    c->subscription = this->cancel_with( token );
 
-                        } else {
-                            this->do_queue<Cont>();
-                        }
-                    }
+                    this->submit( std::move( c ), last_status );
 
-                    //I love this line. So succinct.
-                    return util::then( c->finished, [result] { return result; }, UV_ASYNC_LAUNCH );
+                    //The promise is satisfied straight from after_work_cb, so nothing has to wait on anything else
+                    return result;
                 }
             }
 
+            /*
+             * Runs work() on the thread-pool, then done( result ) on the loop thread straight from after_work_cb, or
+             * fail( std::exception_ptr ) if it threw or was cancelled. No promise or future is created at all, so
+             * this is the cheapest way to queue work when the loop is what needs the result.
+             * */
+            template <typename Functor, typename Done, typename Fail = detail::IgnoreFailure,
+                      typename = typename std::enable_if<detail::is_work_callback<typename std::decay<Functor>::type, Done>::value>::type>
+            void queue( Functor &&work, Done &&done, Fail &&fail = Fail()) {
+                typedef typename std::decay<Functor>::type functor_type;
+                typedef detail::WorkCallback<functor_type, Work, typename std::decay<Done>::type, typename std::decay<Fail>::type> Cont;
+
+                int last_status = _status.fetch_and( REQUEST_ACTIVE );
+
+                if( last_status == REQUEST_ACTIVE ) {
+                    throw ::uv::Exception( UV_EBUSY );
+                }
+
+                this->check_submit( last_status );
+
+                auto c = std::make_shared<Cont>( std::forward<Functor>( work ), std::forward<Done>( done ), std::forward<Fail>( fail ));
+
+                c->store_args( std::static_pointer_cast<Work>( this->shared_from_this()));
+
+                //Nothing to cancel it with, but a cancel left over from an earlier use must not hit this one
+                this->cancel_with( CancellationToken());
+
+                this->submit( std::move( c ), last_status );
+            }
+
             template <typename Functor, typename... Args>
-            inline std::future<detail::fn_result_of<Functor>> defer_queue( Functor f, Args... args ) {
-                return std::async( std::launch::deferred, [this]( Functor inner_f, Args &&... inner_args ) {
-                    return this->queue( inner_f, std::forward<Args>( inner_args )... ).get();
-                }, f, std::forward<Args>( args )... );
+            inline std::future<detail::fn_result_of<Functor>> defer_queue( Functor &&f, Args &&... args ) {
+                return std::async( std::launch::deferred, [this]( typename std::decay<Functor>::type &&inner_f,
+                                                                  typename std::decay<Args>::type &&... inner_args ) {
+                    return this->queue( std::move( inner_f ), std::move( inner_args )... ).get();
+                }, std::forward<Functor>( f ), std::forward<Args>( args )... );
             };
     };
 }
@@ -0,0 +1,433 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_SYNC_HPP
+#define UV_SYNC_HPP
+
+#include "loop.hpp"
+
+namespace uv {
+    /*
+     * Intrusive waiter node for the asynchronous coordination primitives.
+     *
+     * Passing your own node means waiting never allocates. It must stay alive until resume is called, which always
+     * happens on the loop thread. cancel is called instead if the primitive is destroyed first, and may be left null.
+     * */
+    struct AsyncWaiter {
+        AsyncWaiter *next = nullptr;
+
+        void (*resume)( AsyncWaiter * ) = nullptr;
+
+        void (*cancel)( AsyncWaiter * ) = nullptr;
+    };
+
+    namespace detail {
+        //FIFO queue of waiters, only ever touched on the loop thread
+        class WaiterQueue {
+            private:
+                AsyncWaiter *head = nullptr;
+                AsyncWaiter *tail = nullptr;
+
+            public:
+                inline void push( AsyncWaiter *w ) noexcept {
+                    w->next = nullptr;
+
+                    if( this->tail != nullptr ) {
+                        this->tail->next = w;
+
+                    } else {
+                        this->head = w;
+                    }
+
+                    this->tail = w;
+                }
+
+                inline AsyncWaiter *pop() noexcept {
+                    AsyncWaiter *w = this->head;
+
+                    if( w != nullptr ) {
+                        this->head = w->next;
+
+                        if( this->head == nullptr ) {
+                            this->tail = nullptr;
+                        }
+
+                        w->next = nullptr;
+                    }
+
+                    return w;
+                }
+
+                //Detaches the whole queue, so waiters can be resumed while new ones are queued up
+                inline AsyncWaiter *take_all() noexcept {
+                    AsyncWaiter *w = this->head;
+
+                    this->head = this->tail = nullptr;
+
+                    return w;
+                }
+
+                inline bool empty() const noexcept {
+                    return this->head == nullptr;
+                }
+        };
+
+        inline void resume_all( AsyncWaiter *w ) {
+            while( w != nullptr ) {
+                AsyncWaiter *next = w->next;
+
+                w->resume( w );
+
+                w = next;
+            }
+        }
+
+        template <typename Functor>
+        struct CallbackWaiter : AsyncWaiter {
+            Functor f;
+
+            inline CallbackWaiter( Functor &&fn )
+                : f( std::move( fn )) {
+                this->resume = []( AsyncWaiter *w ) {
+                    std::unique_ptr<CallbackWaiter> c( static_cast<CallbackWaiter *>(w));
+
+                    c->f();
+                };
+
+                this->cancel = []( AsyncWaiter *w ) {
+                    delete static_cast<CallbackWaiter *>(w);
+                };
+            }
+        };
+
+        struct PromiseWaiter : AsyncWaiter {
+            std::promise<void> result;
+
+            inline PromiseWaiter() {
+                this->resume = []( AsyncWaiter *w ) {
+                    std::unique_ptr<PromiseWaiter> p( static_cast<PromiseWaiter *>(w));
+
+                    p->result.set_value();
+                };
+
+                this->cancel = []( AsyncWaiter *w ) {
+                    std::unique_ptr<PromiseWaiter> p( static_cast<PromiseWaiter *>(w));
+
+                    p->result.set_exception( std::make_exception_ptr( ::uv::Exception( UV_ECANCELED )));
+                };
+            }
+        };
+
+        template <typename Functor>
+        using enable_if_callback = typename std::enable_if<!std::is_convertible<Functor, AsyncWaiter *>::value>::type;
+
+        /*
+         * Shared parts of the primitives. Their state is only ever touched on the loop thread, and operations from
+         * other threads are sent there through Loop::post, since nothing waits on them being handed over.
+         * */
+        class AsyncPrimitive : public std::enable_shared_from_this<AsyncPrimitive> {
+            protected:
+                std::shared_ptr<Loop> _loop;
+                WaiterQueue           waiters;
+
+                inline explicit AsyncPrimitive( std::shared_ptr<Loop> l ) noexcept
+                    : _loop( l ) {
+                }
+
+                template <typename Functor>
+                void on_loop( Functor &&f ) {
+                    if( this->_loop->on_loop_thread()) {
+                        f();
+
+                    } else {
+                        auto self = this->shared_from_this();
+
+                        this->_loop->post( [self, f]() mutable {
+                            f();
+                        } );
+                    }
+                }
+
+                //Either resumes the waiter right away or queues it, on the loop thread
+                virtual void _wait( AsyncWaiter * ) = 0;
+
+                inline void wait_node( AsyncWaiter *w ) {
+                    assert( w != nullptr && w->resume != nullptr );
+
+                    this->on_loop( [this, w] {
+                        this->_wait( w );
+                    } );
+                }
+
+                template <typename Functor>
+                inline void wait_callback( Functor &&f ) {
+                    this->wait_node( new CallbackWaiter<typename std::decay<Functor>::type>( std::forward<Functor>( f )));
+                }
+
+                inline std::shared_future<void> wait_future() {
+                    PromiseWaiter *p = new PromiseWaiter();
+
+                    std::shared_future<void> ret = p->result.get_future();
+
+                    this->wait_node( p );
+
+                    return ret;
+                }
+
+            public:
+                AsyncPrimitive( const AsyncPrimitive & ) = delete;
+
+                inline std::shared_ptr<Loop> loop() const noexcept {
+                    return this->_loop;
+                }
+
+                virtual ~AsyncPrimitive() {
+                    AsyncWaiter *w = this->waiters.take_all();
+
+                    while( w != nullptr ) {
+                        AsyncWaiter *next = w->next;
+
+                        if( w->cancel != nullptr ) {
+                            w->cancel( w );
+                        }
+
+                        w = next;
+                    }
+                }
+        };
+    }
+
+    /*
+     * Counting semaphore whose waiters resume on the loop instead of blocking a thread.
+     *
+     * Waiters are resumed in the order they started waiting. A waiter that can acquire right away is resumed
+     * immediately, from within acquire if that was called on the loop thread.
+     * */
+    class AsyncSemaphore : public detail::AsyncPrimitive {
+        protected:
+            size_t count;
+
+            void _wait( AsyncWaiter *w ) override {
+                if( this->count > 0 && this->waiters.empty()) {
+                    --this->count;
+
+                    w->resume( w );
+
+                } else {
+                    this->waiters.push( w );
+                }
+            }
+
+            void _release( size_t n ) {
+                this->count += n;
+
+                while( this->count > 0 && !this->waiters.empty()) {
+                    --this->count;
+
+                    AsyncWaiter *w = this->waiters.pop();
+
+                    w->resume( w );
+                }
+            }
+
+        public:
+            inline AsyncSemaphore( std::shared_ptr<Loop> l, size_t initial ) noexcept
+                : AsyncPrimitive( l ), count( initial ) {
+            }
+
+            static inline std::shared_ptr<AsyncSemaphore> make_semaphore( std::shared_ptr<Loop> l, size_t initial ) {
+                return std::make_shared<AsyncSemaphore>( l, initial );
+            }
+
+            inline void acquire( AsyncWaiter *w ) {
+                this->wait_node( w );
+            }
+
+            template <typename Functor, typename = detail::enable_if_callback<Functor>>
+            inline void acquire( Functor &&f ) {
+                this->wait_callback( std::forward<Functor>( f ));
+            }
+
+            inline std::shared_future<void> acquire() {
+                return this->wait_future();
+            }
+
+            //Only on the loop thread
+            inline bool try_acquire() noexcept {
+                assert( this->_loop->on_loop_thread());
+
+                if( this->count > 0 && this->waiters.empty()) {
+                    --this->count;
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            inline void release( size_t n = 1 ) {
+                this->on_loop( [this, n] {
+                    this->_release( n );
+                } );
+            }
+
+            //Only meaningful on the loop thread
+            inline size_t available() const noexcept {
+                return this->count;
+            }
+    };
+
+    /*
+     * Mutual exclusion for asynchronous operations on one loop, so a sequence of callbacks can hold a lock
+     * across several loop iterations.
+     * */
+    class AsyncMutex : public AsyncSemaphore {
+        public:
+            inline explicit AsyncMutex( std::shared_ptr<Loop> l ) noexcept
+                : AsyncSemaphore( l, 1 ) {
+            }
+
+            static inline std::shared_ptr<AsyncMutex> make_mutex( std::shared_ptr<Loop> l ) {
+                return std::make_shared<AsyncMutex>( l );
+            }
+
+            inline void lock( AsyncWaiter *w ) {
+                this->acquire( w );
+            }
+
+            template <typename Functor, typename = detail::enable_if_callback<Functor>>
+            inline void lock( Functor &&f ) {
+                this->acquire( std::forward<Functor>( f ));
+            }
+
+            inline std::shared_future<void> lock() {
+                return this->acquire();
+            }
+
+            inline bool try_lock() noexcept {
+                return this->try_acquire();
+            }
+
+            inline void unlock() {
+                this->release( 1 );
+            }
+
+            inline bool is_locked() const noexcept {
+                return this->count == 0;
+            }
+    };
+
+    /*
+     * Single use countdown. Everything waiting on it resumes once it reaches zero, and anything waiting after that
+     * resumes immediately.
+     * */
+    class Latch : public detail::AsyncPrimitive {
+        protected:
+            size_t count;
+
+            void _wait( AsyncWaiter *w ) override {
+                if( this->count == 0 ) {
+                    w->resume( w );
+
+                } else {
+                    this->waiters.push( w );
+                }
+            }
+
+        public:
+            inline Latch( std::shared_ptr<Loop> l, size_t expected ) noexcept
+                : AsyncPrimitive( l ), count( expected ) {
+            }
+
+            static inline std::shared_ptr<Latch> make_latch( std::shared_ptr<Loop> l, size_t expected ) {
+                return std::make_shared<Latch>( l, expected );
+            }
+
+            inline void count_down( size_t n = 1 ) {
+                this->on_loop( [this, n] {
+                    if( this->count == 0 ) {
+                        return;
+                    }
+
+                    this->count = n < this->count ? this->count - n : 0;
+
+                    if( this->count == 0 ) {
+                        detail::resume_all( this->waiters.take_all());
+                    }
+                } );
+            }
+
+            inline void wait( AsyncWaiter *w ) {
+                this->wait_node( w );
+            }
+
+            template <typename Functor, typename = detail::enable_if_callback<Functor>>
+            inline void wait( Functor &&f ) {
+                this->wait_callback( std::forward<Functor>( f ));
+            }
+
+            inline std::shared_future<void> wait() {
+                return this->wait_future();
+            }
+
+            //Only meaningful on the loop thread
+            inline bool is_ready() const noexcept {
+                return this->count == 0;
+            }
+    };
+
+    /*
+     * Reusable barrier. Every participant arrives and waits, and once the last one arrives they all resume
+     * and the barrier starts over for the next phase.
+     * */
+    class Barrier : public detail::AsyncPrimitive {
+        protected:
+            size_t expected;
+            size_t arrived = 0;
+            size_t phase   = 0;
+
+            void _wait( AsyncWaiter *w ) override {
+                this->waiters.push( w );
+
+                if( ++this->arrived == this->expected ) {
+                    //Reset first, so anything resumed can arrive again for the next phase
+                    this->arrived = 0;
+
+                    ++this->phase;
+
+                    detail::resume_all( this->waiters.take_all());
+                }
+            }
+
+        public:
+            inline Barrier( std::shared_ptr<Loop> l, size_t expected ) noexcept
+                : AsyncPrimitive( l ), expected( expected ) {
+                assert( expected > 0 );
+            }
+
+            static inline std::shared_ptr<Barrier> make_barrier( std::shared_ptr<Loop> l, size_t expected ) {
+                return std::make_shared<Barrier>( l, expected );
+            }
+
+            inline void arrive_and_wait( AsyncWaiter *w ) {
+                this->wait_node( w );
+            }
+
+            template <typename Functor, typename = detail::enable_if_callback<Functor>>
+            inline void arrive_and_wait( Functor &&f ) {
+                this->wait_callback( std::forward<Functor>( f ));
+            }
+
+            inline std::shared_future<void> arrive_and_wait() {
+                return this->wait_future();
+            }
+
+            //Number of completed phases, only meaningful on the loop thread
+            inline size_t generation() const noexcept {
+                return this->phase;
+            }
+    };
+}
+
+#endif //UV_SYNC_HPP
@@ -0,0 +1,281 @@
+//
+// Created by Aaron on 10/18/2026.
+//
+
+#ifndef UV_WHEN_HPP
+#define UV_WHEN_HPP
+
+#include "loop.hpp"
+
+#include <tuple>
+#include <vector>
+#include <iterator>
+
+namespace uv {
+    /*
+     * Result of when_any. index is the position of the first input that completed, and futures holds all of the
+     * inputs, so the rest can still be waited on or chained.
+     * */
+    template <typename Sequence>
+    struct WhenAnyResult {
+        size_t   index;
+        Sequence futures;
+    };
+
+    namespace detail {
+        /*
+         * Inputs can be uv::Futures, or std::futures like the ones from Work::queue, which are handed to the loop
+         * to be polled since they have no way of notifying anything.
+         * */
+        template <typename T>
+        inline Future<T> when_input( Loop *, Future<T> &&f ) {
+            return std::move( f );
+        }
+
+        template <typename T>
+        inline Future<T> when_input( Loop *l, std::future<T> &&f ) {
+            return l->poll_future( std::move( f ));
+        }
+
+        template <typename T>
+        inline Future<T> when_input( Loop *l, std::shared_future<T> f ) {
+            return l->poll_future( std::move( f ));
+        }
+
+        template <typename F>
+        using when_future_t = decltype( when_input( std::declval<Loop *>(), std::declval<typename std::decay<F>::type>()));
+
+        //Calls f( index, state ) for every future in a vector or tuple
+        template <typename T, typename Functor>
+        inline void when_each( std::vector<Future<T>> &futures, Functor &&f ) {
+            for( size_t i = 0; i < futures.size(); ++i ) {
+                f( i, future_access::state( futures[i] ));
+            }
+        }
+
+        template <typename... Ts, typename Functor, size_t... I>
+        inline void when_each( std::tuple<Future<Ts>...> &futures, Functor &&f, std::index_sequence<I...> ) {
+            int expand[] = { 0, ( f( I, future_access::state( std::get<I>( futures ))), 0 )... };
+
+            (void)expand;
+        }
+
+        template <typename... Ts, typename Functor>
+        inline void when_each( std::tuple<Future<Ts>...> &futures, Functor &&f ) {
+            when_each( futures, std::forward<Functor>( f ), std::make_index_sequence<sizeof...( Ts )>());
+        }
+
+        template <typename T>
+        inline size_t when_size( const std::vector<Future<T>> &futures ) noexcept {
+            return futures.size();
+        }
+
+        template <typename... Ts>
+        inline constexpr size_t when_size( const std::tuple<Future<Ts>...> & ) noexcept {
+            return sizeof...( Ts );
+        }
+
+        struct WhenNode : FutureNode {
+            void   *owner;
+            size_t index;
+            bool   attached;
+        };
+
+        /*
+         * Shared by every input of a when_all or when_any, in one allocation along with the nodes attached to each
+         * input, so nothing is allocated per input. Each input completing decrements a single counter, and the result
+         * is set on the loop once the combinator is satisfied.
+         *
+         * The counter starts with an extra count for attaching the nodes, so the inputs aren't moved into the result
+         * while that's still going on.
+         * */
+        template <typename Sequence, typename Result, bool Any>
+        class WhenState {
+            protected:
+                Sequence              futures;
+                std::vector<WhenNode> nodes;
+                Promise<Result>       promise;
+                LoopExecutor          executor;
+
+                //Inputs that haven't completed yet, plus one until everything is attached, and for when_any, one for finish
+                std::atomic<size_t> remaining;
+
+                //when_any only. The first input to complete, and a gate that opens once it's known and attaching is done
+                std::atomic<size_t> first;
+                std::atomic<int>    gate;
+
+                template <bool A = Any>
+                inline typename std::enable_if<!A, Result>::type result() {
+                    return std::move( this->futures );
+                }
+
+                template <bool A = Any>
+                inline typename std::enable_if<A, Result>::type result() {
+                    return Result{ this->first.load( std::memory_order_acquire ), std::move( this->futures ) };
+                }
+
+                static void finish( void *p ) {
+                    WhenState *self = static_cast<WhenState *>(p);
+
+                    self->promise.set_value( self->result());
+
+                    if( !Any ) {
+                        delete self;
+
+                    } else {
+                        self->release();
+                    }
+                }
+
+                inline void open_gate() {
+                    if( this->gate.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                        this->executor.execute( &WhenState::finish, this );
+                    }
+                }
+
+                //For when_any, the nodes stay attached to the inputs that haven't completed, so the state has to outlive them
+                inline void release() {
+                    if( this->remaining.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                        delete this;
+                    }
+                }
+
+                void ready( size_t index ) {
+                    if( Any ) {
+                        size_t none = SIZE_MAX;
+
+                        if( this->first.compare_exchange_strong( none, index, std::memory_order_acq_rel )) {
+                            this->open_gate();
+                        }
+
+                        this->release();
+
+                    } else if( this->remaining.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+                        this->executor.execute( &WhenState::finish, this );
+                    }
+                }
+
+            public:
+                inline WhenState( Sequence &&f, std::shared_ptr<Loop> l )
+                    : futures( std::move( f )), executor{ std::move( l ) }, first( SIZE_MAX ), gate( 2 ) {
+                    size_t n = when_size( this->futures );
+
+                    this->remaining.store( n + ( Any ? 2 : 1 ), std::memory_order_relaxed );
+
+                    this->nodes.resize( n );
+                }
+
+                inline Future<Result> get_future() {
+                    return this->promise.get_future();
+                }
+
+                //Attaches a node to every input. The state deletes itself once it's done.
+                void start() {
+                    when_each( this->futures, [this]( size_t i, auto *s ) {
+                        WhenNode &n = this->nodes[i];
+
+                        n.owner    = this;
+                        n.index    = i;
+                        n.run      = []( FutureNode *fn ) {
+                            WhenNode *wn = static_cast<WhenNode *>(fn);
+
+                            static_cast<WhenState *>(wn->owner)->ready( wn->index );
+                        };
+                        n.attached = s->attach( &n );
+                    } );
+
+                    //Inputs that were ready already never had their node attached
+                    for( WhenNode &n : this->nodes ) {
+                        if( !n.attached ) {
+                            this->ready( n.index );
+                        }
+                    }
+
+                    if( Any ) {
+                        //With no inputs at all, when_any completes right away with an index of SIZE_MAX
+                        if( this->nodes.empty()) {
+                            this->open_gate();
+                        }
+
+                        this->open_gate();
+
+                        this->release();
+
+                    } else {
+                        this->ready( SIZE_MAX );
+                    }
+                }
+        };
+
+        template <typename Sequence, typename Result, bool Any>
+        inline Future<Result> when_start( std::shared_ptr<Loop> l, Sequence &&futures ) {
+            auto *s = new WhenState<Sequence, Result, Any>( std::move( futures ), std::move( l ));
+
+            Future<Result> f = s->get_future();
+
+            s->start();
+
+            return f;
+        }
+
+        template <typename Iterator>
+        using when_range_t = std::vector<when_future_t<typename std::iterator_traits<Iterator>::value_type>>;
+    }
+
+    /*
+     * Completes on the loop once every input has, handing the inputs back ready to be read. Inputs are uv::Futures,
+     * or std::futures which are polled by the loop. Nothing blocks, and the only allocations are the shared state
+     * and the result itself.
+     *
+     * Inputs are moved from, so a range has to be of rvalues, like with std::make_move_iterator, or std::futures.
+     * */
+    template <typename Iterator>
+    Future<detail::when_range_t<Iterator>> when_all( std::shared_ptr<Loop> l, Iterator first, Iterator last ) {
+        detail::when_range_t<Iterator> futures;
+
+        futures.reserve( std::distance( first, last ));
+
+        for( ; first != last; ++first ) {
+            futures.push_back( detail::when_input( l.get(), std::move( *first )));
+        }
+
+        return detail::when_start<detail::when_range_t<Iterator>, detail::when_range_t<Iterator>, false>( std::move( l ), std::move( futures ));
+    }
+
+    template <typename... Futures>
+    Future<std::tuple<detail::when_future_t<Futures>...>> when_all( std::shared_ptr<Loop> l, Futures &&... fs ) {
+        typedef std::tuple<detail::when_future_t<Futures>...> Sequence;
+
+        Sequence futures( detail::when_input( l.get(), std::forward<Futures>( fs ))... );
+
+        return detail::when_start<Sequence, Sequence, false>( std::move( l ), std::move( futures ));
+    }
+
+    /*
+     * Completes on the loop as soon as any input has, with the index of the first one and all of the inputs, so the
+     * rest can still be used. With no inputs it completes right away, with an index of SIZE_MAX.
+     * */
+    template <typename Iterator>
+    Future<WhenAnyResult<detail::when_range_t<Iterator>>> when_any( std::shared_ptr<Loop> l, Iterator first, Iterator last ) {
+        detail::when_range_t<Iterator> futures;
+
+        futures.reserve( std::distance( first, last ));
+
+        for( ; first != last; ++first ) {
+            futures.push_back( detail::when_input( l.get(), std::move( *first )));
+        }
+
+        return detail::when_start<detail::when_range_t<Iterator>, WhenAnyResult<detail::when_range_t<Iterator>>, true>( std::move( l ), std::move( futures ));
+    }
+
+    template <typename... Futures>
+    Future<WhenAnyResult<std::tuple<detail::when_future_t<Futures>...>>> when_any( std::shared_ptr<Loop> l, Futures &&... fs ) {
+        typedef std::tuple<detail::when_future_t<Futures>...> Sequence;
+
+        Sequence futures( detail::when_input( l.get(), std::forward<Futures>( fs ))... );
+
+        return detail::when_start<Sequence, WhenAnyResult<Sequence>, true>( std::move( l ), std::move( futures ));
+    }
+}
+
+#endif //UV_WHEN_HPP